@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cstdarg>
 #include <iterator>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -18,13 +19,23 @@ namespace Nextsim {
 
 ModelArray::SizeMap ModelArray::m_sz;
 ModelArray::DimensionMap ModelArray::m_dims;
-bool ModelArray::areMapsInvalid = true;
+std::atomic<bool> ModelArray::areMapsInvalid(true);
+// Serializes the revalidation of the size maps
+static std::mutex validationMutex;
 
 ModelArray::ModelArray(const Type type)
     : type(type)
 {
+    // The size maps are revalidated whenever a dimension changes, so only
+    // the first construction needs to do it. Constructing an array then
+    // writes no static data, and so can happen on several threads at once.
+    // validateMaps() checks the flag again under its lock, so the maps are
+    // only rewritten by the first thread to see them invalid. It clears the
+    // flag last, so a thread that sees the flag clear also sees the valid
+    // maps.
+    if (areMapsInvalid)
+        validateMaps();
     m_data.resize(std::max(std::size_t { 0 }, m_sz.at(type)), nComponents());
-    validateMaps();
 }
 
 ModelArray::ModelArray(const ModelArray& orig)
@@ -33,6 +44,12 @@ ModelArray::ModelArray(const ModelArray& orig)
     setData(orig.m_data);
 }
 
+ModelArray::ModelArray(ModelArray&& orig) noexcept
+    : type(orig.type)
+    , m_data(std::move(orig.m_data))
+{
+}
+
 ModelArray& ModelArray::operator=(const ModelArray& orig)
 {
     type = orig.type;
@@ -41,6 +58,14 @@ ModelArray& ModelArray::operator=(const ModelArray& orig)
     return *this;
 }
 
+ModelArray& ModelArray::operator=(ModelArray&& orig) noexcept
+{
+    type = orig.type;
+    m_data.swap(orig.m_data);
+
+    return *this;
+}
+
 ModelArray& ModelArray::operator=(const double& fill)
 {
     setData(fill);
@@ -48,123 +73,150 @@ ModelArray& ModelArray::operator=(const double& fill)
     return *this;
 }
 
-ModelArray ModelArray::operator+(const ModelArray& addend) const
+ModelArray ModelArray::operator+(const ModelArray& addend) &&
+{
+    m_data += addend.m_data;
+    return std::move(*this);
+}
+
+ModelArray ModelArray::operator+(ModelArray&& addend) const&
+{
+    addend.type = type;
+    addend.m_data = m_data + addend.m_data;
+    return std::move(addend);
+}
+
+ModelArray ModelArray::operator-(const ModelArray& subtrahend) &&
+{
+    m_data -= subtrahend.m_data;
+    return std::move(*this);
+}
+
+ModelArray ModelArray::operator-(ModelArray&& subtrahend) const&
+{
+    subtrahend.type = type;
+    subtrahend.m_data = m_data - subtrahend.m_data;
+    return std::move(subtrahend);
+}
+
+ModelArray ModelArray::operator*(const ModelArray& multiplier) &&
 {
-    ModelArray result = *this;
-    return result += addend;
+    m_data *= multiplier.m_data;
+    return std::move(*this);
 }
 
-ModelArray ModelArray::operator-(const ModelArray& subtrahend) const
+ModelArray ModelArray::operator*(ModelArray&& multiplier) const&
 {
-    ModelArray result = *this;
-    return result -= subtrahend;
+    multiplier.type = type;
+    multiplier.m_data = m_data * multiplier.m_data;
+    return std::move(multiplier);
 }
 
-ModelArray ModelArray::operator*(const ModelArray& multiplier) const
+ModelArray ModelArray::operator/(const ModelArray& divisor) &&
 {
-    ModelArray result = *this;
-    return result *= multiplier;
+    m_data /= divisor.m_data;
+    return std::move(*this);
 }
 
-ModelArray ModelArray::operator/(const ModelArray& divisor) const
+ModelArray ModelArray::operator/(ModelArray&& divisor) const&
 {
-    ModelArray result = *this;
-    return result /= divisor;
+    divisor.type = type;
+    divisor.m_data = m_data / divisor.m_data;
+    return std::move(divisor);
 }
 
-ModelArray ModelArray::operator-() const
+ModelArray ModelArray::operator-() &&
 {
-    ModelArray copy(type);
-    copy.m_data = -m_data;
-    return copy;
+    m_data = -m_data;
+    return std::move(*this);
 }
 
-ModelArray ModelArray::operator+(const double& x) const
+ModelArray ModelArray::operator+(const double& x) &&
 {
-    ModelArray result = *this;
-    return result += x;
+    m_data += x;
+    return std::move(*this);
 }
 
-ModelArray ModelArray::operator-(const double& x) const
+ModelArray ModelArray::operator-(const double& x) &&
 {
-    ModelArray result = *this;
-    return result -= x;
+    m_data -= x;
+    return std::move(*this);
 }
 
-ModelArray ModelArray::operator*(const double& x) const
+ModelArray ModelArray::operator*(const double& x) &&
 {
-    ModelArray result = *this;
-    return result *= x;
+    m_data *= x;
+    return std::move(*this);
 }
 
-ModelArray ModelArray::operator/(const double& x) const
+ModelArray ModelArray::operator/(const double& x) &&
 {
-    ModelArray result = *this;
-    return result /= x;
+    m_data /= x;
+    return std::move(*this);
 }
 
-ModelArray operator+(const double& x, const ModelArray& y) { return y + x; }
+ModelArray operator+(const double& x, ModelArray&& y) { return std::move(y) + x; }
 
-ModelArray operator-(const double& x, const ModelArray& y) { return -(y - x); }
+ModelArray operator-(const double& x, ModelArray&& y)
+{
+    y.m_data = x - y.m_data;
+    return std::move(y);
+}
 
-ModelArray operator*(const double& x, const ModelArray& y) { return y * x; }
+ModelArray operator*(const double& x, ModelArray&& y) { return std::move(y) * x; }
 
-ModelArray operator/(const double& x, const ModelArray& y)
+ModelArray operator/(const double& x, ModelArray&& y)
 {
-    ModelArray xArray(y.getType());
-    xArray.setData(x);
-    return xArray /= y;
+    y.m_data = x / y.m_data;
+    return std::move(y);
 }
 
-ModelArray ModelArray::max(double max) const
+ModelArray ModelArray::max(double max) &&
 {
-    ModelArray maxed = ModelArray(type);
-    maxed.m_data.array() = m_data.array().max(max);
-    return maxed;
+    clampAbove(max);
+    return std::move(*this);
 }
 
-ModelArray ModelArray::min(double min) const
+ModelArray ModelArray::min(double min) &&
 {
-    ModelArray mined = ModelArray(type);
-    mined.m_data.array() = m_data.array().min(min);
-    return mined;
+    clampBelow(min);
+    return std::move(*this);
 }
 
-ModelArray ModelArray::max(const ModelArray& maxArr) const
+ModelArray ModelArray::max(const ModelArray& maxArr) &&
 {
-    ModelArray maxed = ModelArray(type);
-    maxed.m_data.array() = m_data.array().max(maxArr.m_data);
-    return maxed;
+    clampAbove(maxArr);
+    return std::move(*this);
 }
 
-ModelArray ModelArray::min(const ModelArray& minArr) const
+ModelArray ModelArray::min(const ModelArray& minArr) &&
 {
-    ModelArray mined = ModelArray(type);
-    mined.m_data.array() = m_data.array().min(minArr.m_data);
-    return mined;
+    clampBelow(minArr);
+    return std::move(*this);
 }
 
+// The clamp functions operate in place, without a temporary array
 ModelArray& ModelArray::clampAbove(double max)
 {
-    m_data = this->max(max).m_data;
+    m_data = m_data.max(max);
     return *this;
 }
 
 ModelArray& ModelArray::clampBelow(double min)
 {
-    m_data = this->min(min).m_data;
+    m_data = m_data.min(min);
     return *this;
 }
 
 ModelArray& ModelArray::clampAbove(const ModelArray& maxArr)
 {
-    m_data = this->max(maxArr).m_data;
+    m_data = m_data.max(maxArr.m_data);
     return *this;
 }
 
 ModelArray& ModelArray::clampBelow(const ModelArray& minArr)
 {
-    m_data = this->min(minArr).m_data;
+    m_data = m_data.min(minArr.m_data);
     return *this;
 }
 
@@ -190,6 +242,7 @@ void ModelArray::setDimensions(Type type, const MultiDim& newDims)
     for (size_t i = 0; i < dimSpecs.size(); ++i) {
         definedDimensions.at(dimSpecs[i]).length = newDims[i];
     }
+    areMapsInvalid = true;
     validateMaps();
 }
 
@@ -203,6 +256,7 @@ void ModelArray::setNComponents(std::map<Type, size_t> cMap)
 void ModelArray::setDimension(Dimension dim, size_t length)
 {
     definedDimensions.at(dim).length = length;
+    areMapsInvalid = true;
     validateMaps();
 }
 
@@ -258,6 +312,10 @@ ModelArray::MultiDim ModelArray::locationFromIndex(Type type, size_t index)
 
 void ModelArray::validateMaps()
 {
+    std::lock_guard<std::mutex> lock(validationMutex);
+    // Another thread may have validated the maps while this one waited
+    if (!areMapsInvalid)
+        return;
     m_dims.validate();
     m_sz.validate();
     areMapsInvalid = false;
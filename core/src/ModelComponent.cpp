@@ -17,6 +17,8 @@ MARConstBackingStore ModelComponent::protectedArrays(static_cast<size_t>(Protect
 ModelArray* ModelComponent::p_oceanMaskH = nullptr;
 size_t ModelComponent::nOcean;
 std::vector<size_t> ModelComponent::oceanIndex;
+std::vector<size_t> ModelComponent::activeIndex;
+std::vector<size_t> ModelComponent::inactiveIndex;
 
 ModelComponent::ModelComponent() { noLandMask(); }
 
@@ -77,6 +79,7 @@ void ModelComponent::setOceanMask(const ModelArray& mask)
 
     // Generate the oceanIndex to grid index mapping
     // 1. Count the number of non-land squares
+    nOcean = 0;
     for (size_t i = 0; i < ModelArray::size(ModelArray::Type::H); ++i) {
         if (oceanMaskH[i] > 0)
             ++nOcean;
@@ -88,6 +91,7 @@ void ModelComponent::setOceanMask(const ModelArray& mask)
             oceanIndex[iOceanIndex++] = i;
         }
     }
+    resetActiveElements();
 }
 
 // Fills the nOcean and OceanIndex variables for the zero land case
@@ -104,6 +108,13 @@ void ModelComponent::noLandMask()
     for (size_t i = 0; i < ModelArray::size(ModelArray::Type::H); ++i) {
         oceanIndex[i] = i;
     }
+    resetActiveElements();
+}
+
+void ModelComponent::resetActiveElements()
+{
+    activeIndex = oceanIndex;
+    inactiveIndex.clear();
 }
 
 ModelArray ModelComponent::mask(const ModelArray& data)
@@ -0,0 +1,234 @@
+/*!
+ * @file ParaGridForcing.cpp
+ *
+ * @date Oct 16, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#include "include/ParaGridForcing.hpp"
+
+#include "include/IStructure.hpp"
+#include "include/gridNames.hpp"
+
+#include <ncDim.h>
+#include <ncGroup.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace Nextsim {
+
+ParaGridForcing::ParaGridForcing(
+    const std::set<std::string>& forcings, const std::string& filePath)
+    : m_filePath(filePath)
+    , m_forcings(forcings)
+    , m_record(noRecord)
+    , m_prefetch(false)
+    , m_nextRecord(noRecord)
+    , m_interpolate(false)
+    , m_weight(0.)
+{
+    std::lock_guard<std::mutex> lock(netCDFMutex());
+    m_file.open(filePath, netCDF::NcFile::read);
+    netCDF::NcGroup dataGroup(m_file.getGroup(IStructure::dataNodeName()));
+
+    // Read the time axis once, converting to TimePoints
+    netCDF::NcDim timeDim = dataGroup.getDim(timeName);
+    netCDF::NcVar timeVar = dataGroup.getVar(timeName);
+    std::vector<double> timeVec(timeDim.getSize());
+    timeVar.getVar(timeVec.data());
+    m_times.reserve(timeVec.size());
+    for (double t : timeVec) {
+        m_times.push_back(TimePoint() + Duration(t));
+    }
+
+    // Hold the variable handles for the duration of the run
+    for (const std::string& varName : m_forcings) {
+        m_vars[varName] = dataGroup.getVar(varName);
+    }
+}
+
+ParaGridForcing::~ParaGridForcing()
+{
+    waitForPrefetch();
+    std::lock_guard<std::mutex> lock(netCDFMutex());
+    m_file.close();
+}
+
+// The constructor of std::mutex is constexpr, so this mutex is constant
+// initialized. It therefore outlives any dynamically initialized static object,
+// such as the held forcing files of ParaGridIO, whose destructors lock it.
+static std::mutex ncMutex;
+
+std::mutex& ParaGridForcing::netCDFMutex() { return ncMutex; }
+
+size_t ParaGridForcing::recordIndex(const TimePoint& time) const
+{
+    // The first record later than the target time
+    size_t targetTIndex = std::upper_bound(m_times.begin(), m_times.end(), time) - m_times.begin();
+    // Rather than the first that is greater than, get the last that is less
+    // than or equal to. But don't go out of bounds.
+    if (targetTIndex > 0)
+        --targetTIndex;
+    return targetTIndex;
+}
+
+void ParaGridForcing::readRecord(size_t record, ModelState& state) const
+{
+    allocate(state);
+    readData(record, state);
+}
+
+void ParaGridForcing::allocate(ModelState& state) const
+{
+    // ASSUME all forcings are HFields: finite volume fields on the same
+    // grid as ice thickness
+    for (const std::string& varName : m_forcings) {
+        // Reuse the existing array and its buffer, where there is one
+        state.data.try_emplace(varName, ModelArray::Type::H).first->second.resize();
+    }
+}
+
+void ParaGridForcing::readData(size_t record, ModelState& state) const
+{
+    std::vector<size_t> indexArray = { record };
+    std::vector<size_t> extentArray = { 1 };
+
+    // Loop over the dimensions of H
+    const std::vector<ModelArray::Dimension>& dimensions
+        = ModelArray::typeDimensions.at(ModelArray::Type::H);
+    for (auto riter = dimensions.rbegin(); riter != dimensions.rend(); ++riter) {
+        indexArray.push_back(0);
+        extentArray.push_back(ModelArray::definedDimensions.at(*riter).length);
+    }
+
+    std::lock_guard<std::mutex> lock(netCDFMutex());
+    for (const auto& [varName, var] : m_vars) {
+        var.getVar(indexArray, extentArray, &state.data.at(varName)[0]);
+    }
+}
+
+void ParaGridForcing::waitForPrefetch()
+{
+    if (m_pending.valid())
+        // Also rethrows any exception from the background read
+        m_pending.get();
+}
+
+void ParaGridForcing::swapArrays(ModelState& a, ModelState& b) const
+{
+    // Swap the arrays individually so that references into either state
+    // stay valid.
+    for (const std::string& varName : m_forcings) {
+        std::swap(a.data.at(varName), b.data.at(varName));
+    }
+}
+
+void ParaGridForcing::fetch(size_t record, ModelState& state)
+{
+    waitForPrefetch();
+    allocate(state);
+    if (record == m_nextRecord) {
+        // The record is already in the prefetch buffer
+        swapArrays(state, m_nextState);
+        m_nextRecord = noRecord;
+    } else {
+        readData(record, state);
+    }
+}
+
+void ParaGridForcing::startPrefetch(size_t record)
+{
+    if (!m_prefetch || record >= nRecords() || record == m_nextRecord)
+        return;
+    waitForPrefetch();
+    // Arrays are only created on this thread, as ModelArray construction
+    // touches the static dimension maps. The background thread only reads
+    // into the existing buffers.
+    allocate(m_nextState);
+    m_nextRecord = record;
+    m_pending
+        = std::async(std::launch::async, [this]() { readData(m_nextRecord, m_nextState); });
+}
+
+void ParaGridForcing::setInterpolate(bool doInterpolate)
+{
+    if (doInterpolate != m_interpolate) {
+        m_interpolate = doInterpolate;
+        // Force the held fields to be recalculated on the next update
+        m_record = noRecord;
+    }
+}
+
+void ParaGridForcing::bind(const std::string& varName, ModelArray& target)
+{
+    m_targets[varName] = &target;
+    // Force the bound field to be written on the next update
+    m_record = noRecord;
+}
+
+ModelArray& ParaGridForcing::output(const std::string& varName)
+{
+    auto iter = m_targets.find(varName);
+    if (iter != m_targets.end())
+        return *iter->second;
+    // Reuse the existing array and its buffer, where there is one
+    ModelArray& held = m_state.data.try_emplace(varName, ModelArray::Type::H).first->second;
+    held.resize();
+    return held;
+}
+
+bool ParaGridForcing::update(const TimePoint& time)
+{
+    size_t record = recordIndex(time);
+    bool isNewRecord = (record != m_record);
+
+    if (!m_interpolate) {
+        if (!isNewRecord)
+            return false;
+        fetch(record, m_state);
+        // Bound fields are copied once per record, not once per update
+        for (const auto& [varName, target] : m_targets) {
+            *target = m_state.data.at(varName);
+        }
+        m_record = record;
+        startPrefetch(record + 1);
+        return true;
+    }
+
+    // Hold the two records bracketing the time, clamped at the end of the file
+    size_t upper = std::min(record + 1, nRecords() - 1);
+    if (isNewRecord) {
+        if (m_record != noRecord && record == m_record + 1) {
+            // Stepping forward by one record, so the old upper bracket
+            // becomes the new lower one
+            swapArrays(m_lower, m_upper);
+        } else {
+            fetch(record, m_lower);
+        }
+        fetch(upper, m_upper);
+        m_record = record;
+        startPrefetch(upper + 1);
+    }
+
+    // The linear interpolation weight of the upper record, zero outside the
+    // time span of the file
+    double weight = 0.;
+    if (upper != record) {
+        weight = (time - m_times[record]).seconds() / (m_times[upper] - m_times[record]).seconds();
+        weight = std::clamp(weight, 0., 1.);
+    }
+    if (!isNewRecord && weight == m_weight)
+        return false;
+
+    for (const std::string& varName : m_forcings) {
+        const ModelArray& lowerData = m_lower.data.at(varName);
+        const ModelArray& upperData = m_upper.data.at(varName);
+        // A single pass over the arrays, without any temporaries
+        output(varName) = lowerData + weight * (upperData - lowerData);
+    }
+    m_weight = weight;
+    return true;
+}
+
+} /* namespace Nextsim */
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace Nextsim {
@@ -51,6 +52,7 @@ const std::map<ModelArray::Dimension, bool> ParaGridIO::isDG = {
 std::map<ModelArray::Dimension, ModelArray::Type> ParaGridIO::dimCompMap;
 std::map<std::string, netCDF::NcFile> ParaGridIO::openFiles;
 std::map<std::string, size_t> ParaGridIO::timeIndexByFile;
+std::map<std::string, std::unique_ptr<ParaGridForcing>> ParaGridIO::forcingFiles;
 
 void ParaGridIO::makeDimCompMap()
 {
@@ -69,6 +71,7 @@ ParaGridIO::~ParaGridIO() = default;
 
 ModelState ParaGridIO::getModelState(const std::string& filePath)
 {
+    std::lock_guard<std::mutex> lock(ParaGridForcing::netCDFMutex());
     netCDF::NcFile ncFile(filePath, netCDF::NcFile::read);
     netCDF::NcGroup metaGroup(ncFile.getGroup(IStructure::metadataNodeName()));
     netCDF::NcGroup dataGroup(ncFile.getGroup(IStructure::dataNodeName()));
@@ -131,57 +134,19 @@ ModelState ParaGridIO::getModelState(const std::string& filePath)
 ModelState ParaGridIO::readForcingTimeStatic(
     const std::set<std::string>& forcings, const TimePoint& time, const std::string& filePath)
 {
-    netCDF::NcFile ncFile(filePath, netCDF::NcFile::read);
-    netCDF::NcGroup metaGroup(ncFile.getGroup(IStructure::metadataNodeName()));
-    netCDF::NcGroup dataGroup(ncFile.getGroup(IStructure::dataNodeName()));
-
-    ModelState state;
-
-    // Read the time axis
-    netCDF::NcDim timeDim = dataGroup.getDim(timeName);
-    // Read the time variable
-    netCDF::NcVar timeVar = dataGroup.getVar(timeName);
-    // Calculate the index of the largest time value on the axis below our target
-    size_t targetTIndex;
-    // Get the time axis as a vector
-    std::vector<double> timeVec(timeDim.getSize());
-    timeVar.getVar(timeVec.data());
-    // Get the index of the largest TimePoint less than the target.
-    targetTIndex = std::find_if(begin(timeVec), end(timeVec), [time](double t) {
-        return (TimePoint() + Duration(t)) > time;
-    }) - timeVec.begin();
-    // Rather than the first that is greater than, get the last that is less
-    // than or equal to. But don't go out of bounds.
-    if (targetTIndex > 0)
-        --targetTIndex;
-    // ASSUME all forcings are HFields: finite volume fields on the same
-    // grid as ice thickness
-    std::vector<size_t> indexArray = { targetTIndex };
-    std::vector<size_t> extentArray = { 1 };
-
-    // Loop over the dimensions of H
-    const std::vector<ModelArray::Dimension>& dimensions
-        = ModelArray::typeDimensions.at(ModelArray::Type::H);
-    for (auto riter = dimensions.rbegin(); riter != dimensions.rend(); ++riter) {
-        indexArray.push_back(0);
-        extentArray.push_back(ModelArray::definedDimensions.at(*riter).length);
+    std::unique_ptr<ParaGridForcing>& forcingFile = forcingFiles[filePath];
+    // (Re)open the file if this is the first read or the forcings have changed
+    if (!forcingFile || forcingFile->forcings() != forcings) {
+        forcingFile = std::make_unique<ParaGridForcing>(forcings, filePath);
     }
-
-    for (const std::string& varName : forcings) {
-        netCDF::NcVar var = dataGroup.getVar(varName);
-        state.data[varName] = ModelArray(ModelArray::Type::H);
-        ModelArray& data = state.data.at(varName);
-        data.resize();
-
-        var.getVar(indexArray, extentArray, &data[0]);
-    }
-    ncFile.close();
-    return state;
+    forcingFile->update(time);
+    return forcingFile->state();
 }
 
 void ParaGridIO::dumpModelState(
     const ModelState& state, const ModelMetadata& metadata, const std::string& filePath)
 {
+    std::lock_guard<std::mutex> lock(ParaGridForcing::netCDFMutex());
     netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
 
     CommonRestartMetadata::writeStructureType(ncFile, metadata);
@@ -237,6 +202,7 @@ void ParaGridIO::dumpModelState(
 void ParaGridIO::writeDiagnosticTime(
     const ModelState& state, const ModelMetadata& meta, const std::string& filePath)
 {
+    std::lock_guard<std::mutex> lock(ParaGridForcing::netCDFMutex());
     bool isNew = openFiles.count(filePath) <= 0;
     size_t nt = (isNew) ? 0 : ++timeIndexByFile.at(filePath);
     if (isNew) {
@@ -364,6 +330,9 @@ void ParaGridIO::writeDiagnosticTime(
 
 void ParaGridIO::close(const std::string& filePath)
 {
+    // Any forcing reader takes the NetCDF lock itself on closing
+    forcingFiles.erase(filePath);
+    std::lock_guard<std::mutex> lock(ParaGridForcing::netCDFMutex());
     if (openFiles.count(filePath) > 0) {
         openFiles.at(filePath).close();
         openFiles.erase(openFiles.find(filePath));
@@ -373,6 +342,7 @@ void ParaGridIO::close(const std::string& filePath)
 
 void ParaGridIO::closeAllFiles()
 {
+    forcingFiles.clear();
     size_t closedFiles = 0;
     for (const auto& [name, handle] : openFiles) {
         if (!handle.isNull()) {
@@ -10,8 +10,17 @@
 #include "include/ModelArrayRef.hpp"
 #include "include/Module.hpp"
 
+#include <stdexcept>
+#include <string>
+
 namespace Nextsim {
 
+template <>
+const std::map<int, std::string> Configured<PrognosticData>::keyMap = {
+    { PrognosticData::DYNAMICS_SUBSTEPS_KEY, "PrognosticData.dynamicsSubsteps" },
+    { PrognosticData::CONCURRENT_KEY, "PrognosticData.concurrentStages" },
+};
+
 PrognosticData::PrognosticData()
     : m_dt(1)
     , m_thick(ModelArray::Type::H)
@@ -31,6 +40,13 @@ PrognosticData::PrognosticData()
 
 void PrognosticData::configure()
 {
+    nDynamicsSubsteps = Configured::getConfiguration(keyMap.at(DYNAMICS_SUBSTEPS_KEY), 1);
+    if (nDynamicsSubsteps < 1) {
+        throw std::invalid_argument(keyMap.at(DYNAMICS_SUBSTEPS_KEY)
+            + " must be at least 1, not " + std::to_string(nDynamicsSubsteps));
+    }
+    concurrentStages = Configured::getConfiguration(keyMap.at(CONCURRENT_KEY), false);
+
     pAtmBdy = &Module::getImplementation<IAtmosphereBoundary>();
     tryConfigure(pAtmBdy);
 
@@ -41,6 +57,16 @@ void PrognosticData::configure()
     tryConfigure(pDynamics);
 
     tryConfigure(iceGrowth);
+
+    buildStages();
+}
+
+ConfigMap PrognosticData::getConfiguration() const
+{
+    return {
+        { keyMap.at(DYNAMICS_SUBSTEPS_KEY), nDynamicsSubsteps },
+        { keyMap.at(CONCURRENT_KEY), concurrentStages },
+    };
 }
 
 void PrognosticData::setData(const ModelState::DataMap& ms)
@@ -70,20 +96,86 @@ void PrognosticData::update(const TimestepTime& tst)
     ModelArrayRef<SharedArray::H_ICE, MARBackingStore, RO> hiceTrueUpd(getSharedArray());
     ModelArrayRef<SharedArray::C_ICE, MARBackingStore, RO> ciceUpd(getSharedArray());
 
-    pOcnBdy->updateBefore(tst);
-    pAtmBdy->update(tst);
+    stages.run(tst, concurrentStages);
+}
 
+/*
+ * The order of the stages is the order of the calculation in the timestep.
+ * The declared arrays only set which stages may run at the same time, so they
+ * must include every array a stage might access, for any implementation of
+ * the modules it calls.
+ */
+void PrognosticData::buildStages()
+{
+    typedef ProtectedArray P;
+    typedef SharedArray S;
+
+    stages.clear();
+    // The external forcings do not depend on any model data
+    stages.addTask(
+        "ocean forcing", [this](const TimestepTime& t) { pOcnBdy->updateForcing(t); }, {},
+        { P::EXT_SST, P::EXT_SSS, P::MLD, P::ML_BULK_CP, P::OCEAN_U, P::OCEAN_V });
+    stages.addTask(
+        "atmosphere forcing", [this](const TimestepTime& t) { pAtmBdy->updateForcing(t); }, {},
+        { P::T_AIR, P::DEW_2M, P::P_AIR, P::MIXRAT, P::SW_IN, P::LW_IN, P::WIND_SPEED,
+            P::WIND_U, P::WIND_V });
+    stages.addTask(
+        "ocean boundary", [this](const TimestepTime& t) { pOcnBdy->updateBefore(t); },
+        { P::EXT_SST, P::EXT_SSS, P::C_ICE },
+        { P::SST, P::SSS, P::MLD, P::ML_BULK_CP, P::TF, P::OCEAN_U, P::OCEAN_V, S::Q_IO });
+    stages.addTask(
+        "atmosphere boundary", [this](const TimestepTime& t) { pAtmBdy->update(t); },
+        { P::SST, P::SSS, P::TF, P::ML_BULK_CP, P::H_ICE, P::C_ICE, P::H_SNOW, P::T_ICE,
+            P::HTRUE_ICE, P::HTRUE_SNOW },
+        { P::T_AIR, P::DEW_2M, P::P_AIR, P::MIXRAT, P::SW_IN, P::LW_IN, P::WIND_SPEED,
+            P::WIND_U, P::WIND_V, P::SNOW, P::EVAP_MINUS_PRECIP, S::Q_IA, S::DQIA_DT, S::Q_OW,
+            S::Q_PEN_SW, S::SUBLIM });
     // Fill the values of the true ice and snow thicknesses.
-    iceGrowth.initializeThicknesses();
-    pDynamics->update(tst);
-    updatePrognosticFields();
-
+    stages.addTask(
+        "ice thicknesses", [this](const TimestepTime&) { iceGrowth.initializeThicknesses(); },
+        { P::H_ICE, P::C_ICE, P::H_SNOW },
+        { P::HTRUE_ICE, P::HTRUE_SNOW, S::H_ICE, S::C_ICE, S::H_SNOW, S::NEW_ICE,
+            S::DELTA_CICE });
+    stages.addTask(
+        "dynamics", [this](const TimestepTime& t) { updateDynamics(t); },
+        { P::WIND_U, P::WIND_V, P::OCEAN_U, P::OCEAN_V },
+        { S::H_ICE, S::C_ICE, S::H_SNOW, P::ICE_U, P::ICE_V });
+    stages.addTask(
+        "dynamics prognostic fields", [this](const TimestepTime&) { updatePrognosticFields(); },
+        { S::H_ICE, S::C_ICE, S::H_SNOW, S::T_ICE }, { P::H_ICE, P::C_ICE, P::H_SNOW, P::T_ICE });
     // Take the updated values of the true ice and snow thicknesses, and reset hice0 and hsnow0
     // IceGrowth updates its own fields during update
-    iceGrowth.update(tst);
-    updatePrognosticFields();
+    stages.addTask(
+        "ice growth", [this](const TimestepTime& t) { iceGrowth.update(t); },
+        { P::H_ICE, P::C_ICE, P::H_SNOW, P::T_ICE, P::SST, P::SSS, P::TF, P::ML_BULK_CP,
+            P::SW_IN, P::SNOW, S::Q_IA, S::DQIA_DT, S::Q_PEN_SW, S::SUBLIM, S::Q_IO },
+        { P::HTRUE_ICE, P::HTRUE_SNOW, S::H_ICE, S::C_ICE, S::H_SNOW, S::T_ICE, S::Q_OW,
+            S::Q_IC, S::HSNOW_MELT, S::DELTA_HICE, S::DELTA_CICE, S::NEW_ICE });
+    stages.addTask(
+        "thermodynamics prognostic fields",
+        [this](const TimestepTime&) { updatePrognosticFields(); },
+        { S::H_ICE, S::C_ICE, S::H_SNOW, S::T_ICE }, { P::H_ICE, P::C_ICE, P::H_SNOW, P::T_ICE });
+    stages.addTask(
+        "ocean update", [this](const TimestepTime& t) { pOcnBdy->updateAfter(t); },
+        { P::C_ICE, P::EXT_SST, P::EXT_SSS, P::MLD, P::ML_BULK_CP, P::TF, P::EVAP_MINUS_PRECIP,
+            S::Q_IO, S::Q_OW, S::HSNOW_MELT, S::NEW_ICE, S::DELTA_HICE },
+        { P::SST, P::SSS, P::SLAB_SST, P::SLAB_SSS, P::SLAB_QDW, P::SLAB_FDW });
+}
 
-    pOcnBdy->updateAfter(tst);
+void PrognosticData::updateDynamics(const TimestepTime& tst)
+{
+    if (nDynamicsSubsteps == 1) {
+        pDynamics->update(tst);
+        return;
+    }
+    // The dynamics works directly on the shared ice fields, so the ice
+    // state carries over from one substep to the next.
+    TimestepTime subTst = tst;
+    subTst.step /= nDynamicsSubsteps;
+    for (int iSub = 0; iSub < nDynamicsSubsteps; ++iSub) {
+        pDynamics->update(subTst);
+        subTst.start += subTst.step;
+    }
 }
 
 void PrognosticData::updatePrognosticFields()
@@ -93,13 +185,10 @@ void PrognosticData::updatePrognosticFields()
     ModelArrayRef<SharedArray::H_SNOW, MARBackingStore, RO> hsnowTrueUpd(getSharedArray());
     ModelArrayRef<SharedArray::T_ICE, MARBackingStore, RO> ticeUpd(getSharedArray());
 
-    // Calculate the cell average thicknesses
-    HField hiceUpd = hiceTrueUpd * ciceUpd;
-    HField hsnowUpd = hsnowTrueUpd * ciceUpd;
-
-    m_thick.setData(hiceUpd);
+    // Calculate the cell average thicknesses, each in a single pass
+    m_thick = hiceTrueUpd * ciceUpd;
     m_conc.setData(ciceUpd);
-    m_snow.setData(hsnowUpd);
+    m_snow = hsnowTrueUpd * ciceUpd;
     m_tice.setData(ticeUpd);
 }
 
@@ -126,9 +215,23 @@ ModelState PrognosticData::getStateRecursive(const OutputSpec& os) const
     return os ? state : ModelState();
 }
 
-PrognosticData::HelpMap& PrognosticData::getHelpText(HelpMap& map, bool getAll) { return map; }
+PrognosticData::HelpMap& PrognosticData::getHelpText(HelpMap& map, bool)
+{
+    map["PrognosticData"] = {
+        { keyMap.at(DYNAMICS_SUBSTEPS_KEY), ConfigType::INTEGER, { "1", "∞" }, "1", "",
+            "The number of dynamics substeps in each model timestep. The forcing and the ice "
+            "thermodynamics are calculated once per model timestep." },
+        { keyMap.at(CONCURRENT_KEY), ConfigType::BOOLEAN, { "true", "false" }, "false", "",
+            "Run the stages of the timestep which do not depend on each other, such as the "
+            "atmosphere forcing and the ocean boundary, at the same time on separate threads. "
+            "Reads from NetCDF files are serialized, so forcing reads from files do not overlap "
+            "each other." },
+    };
+    return map;
+}
 PrognosticData::HelpMap& PrognosticData::getHelpRecursive(HelpMap& map, bool getAll)
 {
+    getHelpText(map, getAll);
     Module::getHelpRecursive<IAtmosphereBoundary>(map, getAll);
     Module::getHelpRecursive<IOceanBoundary>(map, getAll);
     Module::getHelpRecursive<IDynamics>(map, getAll);
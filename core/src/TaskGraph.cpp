@@ -0,0 +1,197 @@
+/*!
+ * @file TaskGraph.cpp
+ *
+ * @date Oct 17, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#include "include/TaskGraph.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Nextsim {
+
+static const size_t nFields = static_cast<size_t>(ModelComponent::ProtectedArray::COUNT)
+    + static_cast<size_t>(ModelComponent::SharedArray::COUNT);
+
+/*
+ * A fixed set of threads which run the tasks of a graph. A task is queued as
+ * ready once all the tasks it depends on have finished, and is then taken by
+ * the first free thread.
+ */
+class TaskGraph::WorkerPool {
+public:
+    WorkerPool(size_t nThreads)
+    {
+        for (size_t i = 0; i < nThreads; ++i) {
+            threads.emplace_back(&WorkerPool::work, this);
+        }
+    }
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    size_t size() const { return threads.size(); }
+
+    // Runs all the tasks, returning the exception of each task that threw
+    std::vector<std::exception_ptr> run(
+        const std::vector<TaskData>& runTasks, const TimestepTime& runTime)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        tasks = &runTasks;
+        tst = &runTime;
+        nFinished = 0;
+        waitingOn.resize(tasks->size());
+        skip.assign(tasks->size(), false);
+        exceptions.assign(tasks->size(), nullptr);
+        for (size_t iTask = 0; iTask < tasks->size(); ++iTask) {
+            waitingOn[iTask] = (*tasks)[iTask].deps.size();
+            if (waitingOn[iTask] == 0)
+                ready.push_back(iTask);
+        }
+        available.notify_all();
+        finished.wait(lock, [this]() { return nFinished == tasks->size(); });
+        tasks = nullptr;
+        tst = nullptr;
+        return exceptions;
+    }
+
+private:
+    void work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            available.wait(lock, [this]() { return stopping || !ready.empty(); });
+            if (stopping)
+                return;
+            size_t iTask = ready.front();
+            ready.pop_front();
+
+            // Tasks that depend on a failed task are not run
+            std::exception_ptr exception;
+            if (!skip[iTask]) {
+                lock.unlock();
+                try {
+                    (*tasks)[iTask].task(*tst);
+                } catch (...) {
+                    exception = std::current_exception();
+                }
+                lock.lock();
+            }
+            exceptions[iTask] = exception;
+
+            for (size_t iDep : (*tasks)[iTask].dependents) {
+                if (skip[iTask] || exception)
+                    skip[iDep] = true;
+                if (--waitingOn[iDep] == 0) {
+                    ready.push_back(iDep);
+                    available.notify_one();
+                }
+            }
+            if (++nFinished == tasks->size())
+                finished.notify_all();
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    // Signals that a task is ready or that the pool is stopping
+    std::condition_variable available;
+    // Signals that all the tasks of the run have finished
+    std::condition_variable finished;
+    bool stopping = false;
+
+    // The state of the current run, guarded by the mutex
+    const std::vector<TaskData>* tasks = nullptr;
+    const TimestepTime* tst = nullptr;
+    std::deque<size_t> ready;
+    std::vector<size_t> waitingOn;
+    std::vector<bool> skip;
+    std::vector<std::exception_ptr> exceptions;
+    size_t nFinished = 0;
+};
+
+TaskGraph::TaskGraph() = default;
+TaskGraph::~TaskGraph() = default;
+
+void TaskGraph::addTask(const std::string& name, Task task, std::initializer_list<Field> reads,
+    std::initializer_list<Field> writes)
+{
+    TaskData data = { name, task, std::vector<bool>(nFields, false),
+        std::vector<bool>(nFields, false), {}, {} };
+    for (const Field& field : reads) {
+        data.reads[field.index] = true;
+    }
+    for (const Field& field : writes) {
+        data.writes[field.index] = true;
+    }
+
+    // Read after write, write after write and write after read all order
+    // the new task after the earlier one
+    for (size_t iTask = 0; iTask < tasks.size(); ++iTask) {
+        TaskData& earlier = tasks[iTask];
+        for (size_t f = 0; f < nFields; ++f) {
+            if ((earlier.writes[f] && (data.reads[f] || data.writes[f]))
+                || (earlier.reads[f] && data.writes[f])) {
+                data.deps.push_back(iTask);
+                earlier.dependents.push_back(tasks.size());
+                break;
+            }
+        }
+    }
+    tasks.push_back(data);
+}
+
+void TaskGraph::clear() { tasks.clear(); }
+
+void TaskGraph::run(const TimestepTime& tst, bool concurrent) const
+{
+    if (!concurrent) {
+        for (const TaskData& data : tasks) {
+            data.task(tst);
+        }
+        return;
+    }
+
+    if (tasks.empty())
+        return;
+    /*
+     * Tasks at the same depth of the graph never depend on each other, so
+     * the largest number of them at one depth can always run at once. The
+     * tasks may wait on I/O, so the pool is not limited to the number of
+     * cores.
+     */
+    std::vector<size_t> depth(tasks.size(), 0);
+    std::vector<size_t> width(tasks.size(), 0);
+    for (size_t iTask = 0; iTask < tasks.size(); ++iTask) {
+        for (size_t iDep : tasks[iTask].deps) {
+            depth[iTask] = std::max(depth[iTask], depth[iDep] + 1);
+        }
+        ++width[depth[iTask]];
+    }
+    const size_t nThreads = *std::max_element(width.begin(), width.end());
+    if (!pool || pool->size() < nThreads) {
+        pool.reset();
+        pool = std::make_unique<WorkerPool>(nThreads);
+    }
+    // Rethrow the exception of the earliest failed task
+    for (const auto& exception : pool->run(tasks, tst)) {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
+
+} /* namespace Nextsim */
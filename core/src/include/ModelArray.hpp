@@ -9,14 +9,18 @@
 #define MODELARRAY_HPP
 
 #include <Eigen/Core>
+#include <atomic>
 #include <cstddef>
 #include <map>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace Nextsim {
 
+template <typename E> class ModelArrayExpression;
+
 /*
  * Set the storage order to row major. This matches with DGVector when there is
  * more than one DG component. If there is only one DG component (the finite
@@ -87,16 +91,35 @@ public:
     ModelArray(const Type type);
     //! Copy constructor
     ModelArray(const ModelArray&);
+    //! Move constructor. Takes over the data buffer of the expiring object.
+    ModelArray(ModelArray&&) noexcept;
+    /*!
+     * @brief Constructs a ModelArray by evaluating a lazy ModelArray expression.
+     *
+     * @param expr The expression to be evaluated.
+     */
+    template <typename E> ModelArray(const ModelArrayExpression<E>& expr);
     virtual ~ModelArray() {};
 
     //! Copy assignment operator
     ModelArray& operator=(const ModelArray&);
+    //! Move assignment operator. Exchanges data buffers with the expiring object.
+    ModelArray& operator=(ModelArray&&) noexcept;
     /*!
      * @brief Assigns a double value to all elements of the object.
      *
      * @param val The value to be assigned.
      */
     ModelArray& operator=(const double& val);
+    /*!
+     * @brief Evaluates a lazy ModelArray expression into the object.
+     *
+     * @details The whole expression is evaluated element by element in a
+     * single pass, without any intermediate arrays.
+     *
+     * @param expr The expression to be evaluated.
+     */
+    template <typename E> ModelArray& operator=(const ModelArrayExpression<E>& expr);
 
     // ModelArray arithmetic
     //! In place addition of another ModelArray
@@ -149,50 +172,83 @@ public:
         return *this;
     }
 
+    //! In place addition of a lazy ModelArray expression
+    template <typename E> ModelArray& operator+=(const ModelArrayExpression<E>& b);
+    //! In place subtraction of a lazy ModelArray expression
+    template <typename E> ModelArray& operator-=(const ModelArrayExpression<E>& b);
+    //! In place multiplication by a lazy ModelArray expression
+    template <typename E> ModelArray& operator*=(const ModelArrayExpression<E>& b);
+    //! In place division by a lazy ModelArray expression
+    template <typename E> ModelArray& operator/=(const ModelArrayExpression<E>& b);
+
+    /*
+     * Arithmetic between ModelArrays, ModelArrayExpressions and doubles
+     * returns a lazy ModelArrayExpression (see below), which is only
+     * evaluated when assigned to a ModelArray. The member operators here
+     * handle an expiring ModelArray operand, where the data buffer of the
+     * operand is reused to hold the result.
+     */
     //! Returns a ModelArray containing the per-element sum of the
     //! object and the provided ModelArray.
-    ModelArray operator+(const ModelArray&) const;
+    ModelArray operator+(const ModelArray&) &&;
+    ModelArray operator+(ModelArray&&) const&;
+    ModelArray operator+(ModelArray&& b) && { return std::move(*this) + std::as_const(b); }
     //! Returns a ModelArray containing the per-element difference between the
     //! object and the provided ModelArray.
-    ModelArray operator-(const ModelArray&) const;
+    ModelArray operator-(const ModelArray&) &&;
+    ModelArray operator-(ModelArray&&) const&;
+    ModelArray operator-(ModelArray&& b) && { return std::move(*this) - std::as_const(b); }
     //! Returns a ModelArray containing the per-element product of the
     //! object and the provided ModelArray.
-    ModelArray operator*(const ModelArray&) const;
+    ModelArray operator*(const ModelArray&) &&;
+    ModelArray operator*(ModelArray&&) const&;
+    ModelArray operator*(ModelArray&& b) && { return std::move(*this) * std::as_const(b); }
     //! Returns a ModelArray containing the per-element ratio between the
     //! object and the provided ModelArray.
-    ModelArray operator/(const ModelArray&) const;
+    ModelArray operator/(const ModelArray&) &&;
+    ModelArray operator/(ModelArray&&) const&;
+    ModelArray operator/(ModelArray&& b) && { return std::move(*this) / std::as_const(b); }
     // Returns a ModelArray containing the element-wise negation of this.
-    ModelArray operator-() const;
+    ModelArray operator-() &&;
 
     //! Returns a ModelArray with a constant added to every element of the object.
-    ModelArray operator+(const double&) const;
+    ModelArray operator+(const double&) &&;
     //! Returns a ModelArray with a constant subtracted from every element of the object.
-    ModelArray operator-(const double&) const;
+    ModelArray operator-(const double&) &&;
     //! Returns a ModelArray with every element of the object multiplied by a constant.
-    ModelArray operator*(const double&) const;
+    ModelArray operator*(const double&) &&;
     //! Returns a ModelArray with every element of the object divided by a constant.
-    ModelArray operator/(const double&) const;
+    ModelArray operator/(const double&) &&;
+
+    // Arithmetic with doubles on the left, where the data buffer of an
+    // expiring ModelArray can be reused.
+    friend ModelArray operator-(const double&, ModelArray&&);
+    friend ModelArray operator/(const double&, ModelArray&&);
 
     /*!
      * @brief Calculates element-wise maximum of the data and the given scalar value.
      * @param max the maximum value of the resultant array.
      */
-    ModelArray max(double max) const;
+    auto max(double max) const&;
+    ModelArray max(double max) &&;
     /*!
      * @brief Calculates element-wise minimum of the data and the given scalar value.
      * @param min the minimum value of the resultant array.
      */
-    ModelArray min(double min) const;
+    auto min(double min) const&;
+    ModelArray min(double min) &&;
     /*!
      * @brief Calculates element-wise maximum of the data and the given second array.
      * @param maxArr the array containing the maximum values.
      */
-    ModelArray max(const ModelArray& maxArr) const;
+    auto max(const ModelArray& maxArr) const&;
+    ModelArray max(const ModelArray& maxArr) &&;
     /*!
      * @brief Calculates element-wise minimum of the data and the given second array.
      * @param minArr the array containing the minimum values.
      */
-    ModelArray min(const ModelArray& minArr) const;
+    auto min(const ModelArray& minArr) const&;
+    ModelArray min(const ModelArray& minArr) &&;
 
     /*!
      * @brief Clamps the values in the array to the given maximum.
@@ -234,6 +290,8 @@ public:
 
     //! Returns a read-only pointer to the underlying data buffer.
     const double* getData() const { return m_data.data(); }
+    //! Returns a pointer to the underlying data buffer.
+    double* getData() { return m_data.data(); }
 
     //! Returns a const reference to the Eigen data
     const DataType& data() const { return m_data; }
@@ -561,7 +619,8 @@ protected:
     }
 
 private:
-    static bool areMapsInvalid;
+    // Atomic, as arrays may be constructed on several threads at once
+    static std::atomic<bool> areMapsInvalid;
     static void validateMaps();
     class SizeMap {
     public:
@@ -603,11 +662,230 @@ private:
 
 #include "include/ModelArrayTypedefs.hpp"
 
-// ModelArray arithmetic with doubles
-ModelArray operator+(const double&, const ModelArray&);
-ModelArray operator-(const double&, const ModelArray&);
-ModelArray operator*(const double&, const ModelArray&);
-ModelArray operator/(const double&, const ModelArray&);
+// ModelArray arithmetic with doubles, reusing the data of an expiring ModelArray
+ModelArray operator+(const double&, ModelArray&&);
+ModelArray operator-(const double&, ModelArray&&);
+ModelArray operator*(const double&, ModelArray&&);
+ModelArray operator/(const double&, ModelArray&&);
+
+/*!
+ * @brief A lazily evaluated element-wise expression of ModelArrays.
+ *
+ * @details Wraps the Eigen array expression built by the ModelArray
+ * arithmetic operators, along with the ModelArray::Type of the result. No
+ * arithmetic is performed until the expression is assigned to, or used to
+ * construct, a ModelArray, when the whole expression is evaluated in a single
+ * (vectorized) pass over the data. As with Eigen expressions, ModelArrays
+ * used in an expression are referenced rather than copied, so an expression
+ * should not outlive its operands.
+ *
+ * @tparam E The type of the underlying Eigen expression.
+ */
+template <typename E> class ModelArrayExpression {
+public:
+    ModelArrayExpression(ModelArray::Type type, const E& expr)
+        : m_type(type)
+        , m_expr(expr)
+    {
+    }
+
+    //! Returns the ModelArray::Type of the result of the expression.
+    ModelArray::Type getType() const { return m_type; }
+    //! Returns the underlying Eigen expression.
+    const E& data() const { return m_expr; }
+
+    //! Returns an expression of the element-wise maximum of this expression and a scalar.
+    auto max(double max) const { return wrap(m_expr.max(max)); }
+    //! Returns an expression of the element-wise minimum of this expression and a scalar.
+    auto min(double min) const { return wrap(m_expr.min(min)); }
+
+private:
+    template <typename F> ModelArrayExpression<F> wrap(const F& expr) const
+    {
+        return ModelArrayExpression<F>(m_type, expr);
+    }
+
+    ModelArray::Type m_type;
+    E m_expr;
+};
+
+/*!
+ * @brief Describes how a type acts as an operand of ModelArray arithmetic.
+ *
+ * @details Specializations define value as true, and provide the Eigen
+ * object that represents an operand and the ModelArray::Type of the operand.
+ * Types without a specialization are not array operands.
+ */
+template <typename T> struct ModelArrayOperand {
+    static const bool value = false;
+};
+
+template <> struct ModelArrayOperand<ModelArray> {
+    static const bool value = true;
+    static const ModelArray::DataType& eigen(const ModelArray& a) { return a.data(); }
+    static ModelArray::Type type(const ModelArray& a) { return a.getType(); }
+};
+
+template <typename E> struct ModelArrayOperand<ModelArrayExpression<E>> {
+    static const bool value = true;
+    static const E& eigen(const ModelArrayExpression<E>& a) { return a.data(); }
+    static ModelArray::Type type(const ModelArrayExpression<E>& a) { return a.getType(); }
+};
+
+template <typename L, typename R>
+using EnableIfModelArrayOperands
+    = std::enable_if_t<ModelArrayOperand<L>::value && ModelArrayOperand<R>::value, bool>;
+template <typename T>
+using EnableIfModelArrayOperand = std::enable_if_t<ModelArrayOperand<T>::value, bool>;
+
+// Wraps an Eigen expression with the ModelArray::Type of the given operand
+template <typename T, typename E>
+ModelArrayExpression<E> makeModelArrayExpression(const T& operand, const E& expr)
+{
+    return ModelArrayExpression<E>(ModelArrayOperand<T>::type(operand), expr);
+}
+
+//! Returns an expression of the per-element sum of two array operands.
+template <typename L, typename R, EnableIfModelArrayOperands<L, R> = true>
+auto operator+(const L& lhs, const R& rhs)
+{
+    return makeModelArrayExpression(
+        lhs, ModelArrayOperand<L>::eigen(lhs) + ModelArrayOperand<R>::eigen(rhs));
+}
+//! Returns an expression of the per-element difference between two array operands.
+template <typename L, typename R, EnableIfModelArrayOperands<L, R> = true>
+auto operator-(const L& lhs, const R& rhs)
+{
+    return makeModelArrayExpression(
+        lhs, ModelArrayOperand<L>::eigen(lhs) - ModelArrayOperand<R>::eigen(rhs));
+}
+//! Returns an expression of the per-element product of two array operands.
+template <typename L, typename R, EnableIfModelArrayOperands<L, R> = true>
+auto operator*(const L& lhs, const R& rhs)
+{
+    return makeModelArrayExpression(
+        lhs, ModelArrayOperand<L>::eigen(lhs) * ModelArrayOperand<R>::eigen(rhs));
+}
+//! Returns an expression of the per-element ratio between two array operands.
+template <typename L, typename R, EnableIfModelArrayOperands<L, R> = true>
+auto operator/(const L& lhs, const R& rhs)
+{
+    return makeModelArrayExpression(
+        lhs, ModelArrayOperand<L>::eigen(lhs) / ModelArrayOperand<R>::eigen(rhs));
+}
+//! Returns an expression of the element-wise negation of an array operand.
+template <typename T, EnableIfModelArrayOperand<T> = true> auto operator-(const T& a)
+{
+    return makeModelArrayExpression(a, -ModelArrayOperand<T>::eigen(a));
+}
+
+//! Returns an expression of an array operand with a constant added to every element.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator+(const T& a, const double& x)
+{
+    return makeModelArrayExpression(a, ModelArrayOperand<T>::eigen(a) + x);
+}
+//! Returns an expression of an array operand with a constant subtracted from every element.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator-(const T& a, const double& x)
+{
+    return makeModelArrayExpression(a, ModelArrayOperand<T>::eigen(a) - x);
+}
+//! Returns an expression of an array operand with every element multiplied by a constant.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator*(const T& a, const double& x)
+{
+    return makeModelArrayExpression(a, ModelArrayOperand<T>::eigen(a) * x);
+}
+//! Returns an expression of an array operand with every element divided by a constant.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator/(const T& a, const double& x)
+{
+    return makeModelArrayExpression(a, ModelArrayOperand<T>::eigen(a) / x);
+}
+
+//! Returns an expression of a constant added to every element of an array operand.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator+(const double& x, const T& a)
+{
+    return makeModelArrayExpression(a, x + ModelArrayOperand<T>::eigen(a));
+}
+//! Returns an expression of every element of an array operand subtracted from a constant.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator-(const double& x, const T& a)
+{
+    return makeModelArrayExpression(a, x - ModelArrayOperand<T>::eigen(a));
+}
+//! Returns an expression of a constant multiplied by every element of an array operand.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator*(const double& x, const T& a)
+{
+    return makeModelArrayExpression(a, x * ModelArrayOperand<T>::eigen(a));
+}
+//! Returns an expression of a constant divided by every element of an array operand.
+template <typename T, EnableIfModelArrayOperand<T> = true>
+auto operator/(const double& x, const T& a)
+{
+    return makeModelArrayExpression(a, x / ModelArrayOperand<T>::eigen(a));
+}
+
+template <typename E>
+ModelArray::ModelArray(const ModelArrayExpression<E>& expr)
+    : type(expr.getType())
+    , m_data(expr.data())
+{
+}
+
+template <typename E> ModelArray& ModelArray::operator=(const ModelArrayExpression<E>& expr)
+{
+    type = expr.getType();
+    m_data = expr.data();
+    return *this;
+}
+
+template <typename E> ModelArray& ModelArray::operator+=(const ModelArrayExpression<E>& b)
+{
+    m_data += b.data();
+    return *this;
+}
+
+template <typename E> ModelArray& ModelArray::operator-=(const ModelArrayExpression<E>& b)
+{
+    m_data -= b.data();
+    return *this;
+}
+
+template <typename E> ModelArray& ModelArray::operator*=(const ModelArrayExpression<E>& b)
+{
+    m_data *= b.data();
+    return *this;
+}
+
+template <typename E> ModelArray& ModelArray::operator/=(const ModelArrayExpression<E>& b)
+{
+    m_data /= b.data();
+    return *this;
+}
+
+inline auto ModelArray::max(double max) const&
+{
+    return makeModelArrayExpression(*this, m_data.max(max));
+}
+
+inline auto ModelArray::min(double min) const&
+{
+    return makeModelArrayExpression(*this, m_data.min(min));
+}
+
+inline auto ModelArray::max(const ModelArray& maxArr) const&
+{
+    return makeModelArrayExpression(*this, m_data.max(maxArr.m_data));
+}
+
+inline auto ModelArray::min(const ModelArray& minArr) const&
+{
+    return makeModelArrayExpression(*this, m_data.min(minArr.m_data));
+}
 } /* namespace Nextsim */
 
 #endif /* MODELARRAY_HPP */
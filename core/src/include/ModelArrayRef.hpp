@@ -9,8 +9,22 @@
 #define MODELARRAYREF2_HPP
 
 #include "ModelArray.hpp"
+#include <utility>
 #include <vector>
 
+/*
+ * Qualifies a pointer as the only way its data is accessed within a scope,
+ * which allows the compiler to keep values in registers across stores
+ * through other pointers, and to vectorize loops.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define NEXTSIM_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define NEXTSIM_RESTRICT __restrict
+#else
+#define NEXTSIM_RESTRICT
+#endif
+
 namespace Nextsim {
 const bool RW = true;
 const bool RO = false;
@@ -151,6 +165,22 @@ public:
         return backingStore[static_cast<size_t>(arrayName)]->zIndexAndLayer(hIndex, layer);
     }
 
+    /*!
+     * @brief Returns a pointer to the data buffer of the referenced ModelArray.
+     *
+     * @details Taking the pointer once for the duration of a kernel avoids
+     * the lookup of the ModelArray in the backing store on every access. The
+     * pointer can be held in a NEXTSIM_RESTRICT qualified variable if no
+     * other pointer to the same data is used in the kernel. It is invalidated
+     * if the referenced ModelArray is resized or a different ModelArray is
+     * registered.
+     */
+    const double* getData() const
+    {
+        checkMaybeThrow();
+        return backingStore[static_cast<size_t>(arrayName)]->getData();
+    }
+
     //! Direct access top the underlying data array.
     const ModelArray& data() const
     {
@@ -160,31 +190,42 @@ public:
     //! Cast the reference class to a real reference to the referenced ModelArray.
     operator const ModelArray&() const { return data(); }
 
-    //! Returns a ModelArray containing the per-element sum of the
-    //! object and the provided ModelArray.
-    ModelArray operator+(const ModelArray& addend) const { return data() + addend; }
-    //! Returns a ModelArray containing the per-element difference between the
-    //! object and the provided ModelArray.
-    ModelArray operator-(const ModelArray& subtrahend) const { return data() - subtrahend; }
-    //! Returns a ModelArray containing the per-element product of the
-    //! object and the provided ModelArray.
-    ModelArray operator*(const ModelArray& multiplier) const { return data() * multiplier; }
-    //! Returns a ModelArray containing the per-element ratio between the
-    //! object and the provided ModelArray.
-    ModelArray operator/(const ModelArray& divisor) const { return data() / divisor; }
+    //! Returns an expression of the per-element sum of the object and the
+    //! provided ModelArray.
+    auto operator+(const ModelArray& addend) const { return data() + addend; }
+    //! Returns an expression of the per-element difference between the object
+    //! and the provided ModelArray.
+    auto operator-(const ModelArray& subtrahend) const { return data() - subtrahend; }
+    //! Returns an expression of the per-element product of the object and the
+    //! provided ModelArray.
+    auto operator*(const ModelArray& multiplier) const { return data() * multiplier; }
+    //! Returns an expression of the per-element ratio between the object and
+    //! the provided ModelArray.
+    auto operator/(const ModelArray& divisor) const { return data() / divisor; }
 
-    //! Returns a ModelArray containing the per-element sum of the
-    //! object and the provided ModelArray.
-    ModelArray operator+(double addend) const { return data() + addend; }
+    //! Returns a ModelArray containing the per-element sum of the object and
+    //! the provided expiring ModelArray, reusing the storage of the latter.
+    ModelArray operator+(ModelArray&& addend) const { return data() + std::move(addend); }
     //! Returns a ModelArray containing the per-element difference between the
-    //! object and the provided ModelArray.
-    ModelArray operator-(double subtrahend) const { return data() - subtrahend; }
-    //! Returns a ModelArray containing the per-element product of the
-    //! object and the provided ModelArray.
-    ModelArray operator*(double multiplier) const { return data() * multiplier; }
+    //! object and the provided expiring ModelArray, reusing the storage of the
+    //! latter.
+    ModelArray operator-(ModelArray&& subtrahend) const { return data() - std::move(subtrahend); }
+    //! Returns a ModelArray containing the per-element product of the object
+    //! and the provided expiring ModelArray, reusing the storage of the latter.
+    ModelArray operator*(ModelArray&& multiplier) const { return data() * std::move(multiplier); }
     //! Returns a ModelArray containing the per-element ratio between the
-    //! object and the provided ModelArray.
-    ModelArray operator/(double divisor) const { return data() / divisor; }
+    //! object and the provided expiring ModelArray, reusing the storage of the
+    //! latter.
+    ModelArray operator/(ModelArray&& divisor) const { return data() / std::move(divisor); }
+
+    //! Returns an expression of the object with a constant added to every element.
+    auto operator+(double addend) const { return data() + addend; }
+    //! Returns an expression of the object with a constant subtracted from every element.
+    auto operator-(double subtrahend) const { return data() - subtrahend; }
+    //! Returns an expression of the object with every element multiplied by a constant.
+    auto operator*(double multiplier) const { return data() * multiplier; }
+    //! Returns an expression of the object with every element divided by a constant.
+    auto operator/(double divisor) const { return data() / divisor; }
 
 private:
     const S& backingStore;
@@ -331,6 +372,18 @@ public:
         return backingStore[static_cast<size_t>(arrayName)]->zIndexAndLayer(hIndex, layer);
     }
 
+    /*!
+     * @brief Returns a pointer to the data buffer of the referenced ModelArray.
+     *
+     * @details See the read-only ModelArrayRef::getData(). The data can be
+     * modified through the returned pointer.
+     */
+    double* getData() const
+    {
+        checkMaybeThrow();
+        return backingStore[static_cast<size_t>(arrayName)]->getData();
+    }
+
     //! Direct access top the underlying data array.
     ModelArray& data() const
     {
@@ -354,5 +407,22 @@ private:
 #endif
     }
 };
+
+/*!
+ * @brief Allows a ModelArrayRef to be used as an operand in lazy ModelArray
+ * expressions, in the same way as the referenced ModelArray.
+ */
+template <auto arrayName, typename S, bool access>
+struct ModelArrayOperand<ModelArrayRef<arrayName, S, access>> {
+    static const bool value = true;
+    static const ModelArray::DataType& eigen(const ModelArrayRef<arrayName, S, access>& a)
+    {
+        return a.data().data();
+    }
+    static ModelArray::Type type(const ModelArrayRef<arrayName, S, access>& a)
+    {
+        return a.data().getType();
+    }
+};
 }
 #endif /* MODELARRAYREF2_HPP */
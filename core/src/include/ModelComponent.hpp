@@ -14,6 +14,7 @@
 #include "include/OutputSpec.hpp"
 #include "include/Time.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -209,13 +210,184 @@ protected:
      */
     static void registerProtectedArray(ProtectedArray type, const ModelArray* addr);
 
-    inline static void overElements(IteratedFn fn, const TimestepTime& tst)
+    /*!
+     * @brief Calls a function on every ocean element of the HField arrays.
+     *
+     * @details The function is called with the HField index of each ocean
+     * element in turn, skipping land elements. The callable is taken as a
+     * template parameter, so that a lambda or function object is called
+     * directly and its body can be inlined into the loop, rather than being
+     * called indirectly through a std::function.
+     *
+     * @param fn The callable, with a signature compatible with IteratedFn.
+     * @param tst The timestep start and length passed to the callable.
+     */
+    template <typename Fn> inline static void overElements(Fn&& fn, const TimestepTime& tst)
     {
+        const size_t* index = oceanIndex.data();
         for (size_t i = 0; i < nOcean; ++i) {
-            fn(oceanIndex[i], tst);
+            fn(index[i], tst);
+        }
+    }
+
+    /*!
+     * @brief Calls a function on every ocean element of the HField arrays,
+     * sharing the elements between threads.
+     *
+     * @details The ocean elements are split into equal contiguous chunks, one
+     * per OpenMP thread, when the model is built with thread support. Each
+     * element is still processed exactly once, so the results are identical
+     * to those of overElements, provided the callable only writes to data at
+     * the index it is given. Without OpenMP, this is the same as
+     * overElements.
+     *
+     * @param fn The callable, with a signature compatible with IteratedFn.
+     * @param tst The timestep start and length passed to the callable.
+     */
+    template <typename Fn>
+    inline static void parallelOverElements(Fn&& fn, const TimestepTime& tst)
+    {
+        const size_t* index = oceanIndex.data();
+        const size_t n = nOcean;
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; ++i) {
+            fn(index[i], tst);
+        }
+    }
+
+    /*!
+     * @brief Calls a function on batches of ocean elements of the HField
+     * arrays, sharing the batches between threads.
+     *
+     * @details The ocean elements are split into consecutive batches of
+     * batchSize elements, with a shorter final batch where the number of ocean
+     * elements is not a multiple of the batch size. The callable is given a
+     * pointer to the HField indices of the elements in the batch and the
+     * number of elements in it. This allows a kernel to process several
+     * columns together in SIMD lanes. As with parallelOverElements, the
+     * batches are only shared between threads when the model is built with
+     * OpenMP.
+     *
+     * @tparam batchSize The maximum number of elements in each batch.
+     * @param fn The callable, with a signature compatible with
+     *           void(const size_t* indices, size_t n, const TimestepTime& tst).
+     * @param tst The timestep start and length passed to the callable.
+     */
+    template <size_t batchSize, typename Fn>
+    inline static void parallelOverElementBatches(Fn&& fn, const TimestepTime& tst)
+    {
+        const size_t* index = oceanIndex.data();
+        const size_t n = nOcean;
+        const size_t nBatches = (n + batchSize - 1) / batchSize;
+#pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < nBatches; ++b) {
+            const size_t start = b * batchSize;
+            fn(index + start, std::min(batchSize, n - start), tst);
+        }
+    }
+
+    /*!
+     * @brief Calls a function on every active ocean element of the HField
+     * arrays, sharing the elements between threads.
+     *
+     * @details The active elements are those selected by the last call to
+     * updateActiveElements(). Until then, or after a new land-ocean mask is
+     * set, all ocean elements are active. Otherwise the same as
+     * parallelOverElements.
+     *
+     * @param fn The callable, with a signature compatible with IteratedFn.
+     * @param tst The timestep start and length passed to the callable.
+     */
+    template <typename Fn>
+    inline static void parallelOverActiveElements(Fn&& fn, const TimestepTime& tst)
+    {
+        const size_t* index = activeIndex.data();
+        const size_t n = activeIndex.size();
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; ++i) {
+            fn(index[i], tst);
+        }
+    }
+
+    /*!
+     * @brief Calls a function on every inactive ocean element of the HField
+     * arrays, sharing the elements between threads.
+     *
+     * @details The inactive elements are the ocean elements which are not
+     * active. See parallelOverActiveElements.
+     *
+     * @param fn The callable, with a signature compatible with IteratedFn.
+     * @param tst The timestep start and length passed to the callable.
+     */
+    template <typename Fn>
+    inline static void parallelOverInactiveElements(Fn&& fn, const TimestepTime& tst)
+    {
+        const size_t* index = inactiveIndex.data();
+        const size_t n = inactiveIndex.size();
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; ++i) {
+            fn(index[i], tst);
         }
     }
 
+    /*!
+     * @brief Calls a function on batches of active ocean elements of the
+     * HField arrays, sharing the batches between threads.
+     *
+     * @details As parallelOverElementBatches, but only over the active
+     * elements. See parallelOverActiveElements.
+     *
+     * @tparam batchSize The maximum number of elements in each batch.
+     * @param fn The callable, with a signature compatible with
+     *           void(const size_t* indices, size_t n, const TimestepTime& tst).
+     * @param tst The timestep start and length passed to the callable.
+     */
+    template <size_t batchSize, typename Fn>
+    inline static void parallelOverActiveElementBatches(Fn&& fn, const TimestepTime& tst)
+    {
+        const size_t* index = activeIndex.data();
+        const size_t n = activeIndex.size();
+        const size_t nBatches = (n + batchSize - 1) / batchSize;
+#pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < nBatches; ++b) {
+            const size_t start = b * batchSize;
+            fn(index + start, std::min(batchSize, n - start), tst);
+        }
+    }
+
+    /*!
+     * @brief Divides the ocean elements into active and inactive elements.
+     *
+     * @details Intended to be called once per timestep, so that the physics
+     * kernels only iterate over the elements where they have any work to do,
+     * such as those with ice or where new ice can form. The inactive elements
+     * can then be handled separately with a cheaper calculation.
+     *
+     * @param isActive A callable taking the HField index of an ocean element
+     *                 and returning true if the element is active.
+     */
+    template <typename Pred> static void updateActiveElements(Pred&& isActive)
+    {
+        // The vectors keep their capacity, so there is no reallocation after
+        // the first call
+        activeIndex.clear();
+        inactiveIndex.clear();
+        for (size_t j = 0; j < nOcean; ++j) {
+            const size_t i = oceanIndex[j];
+            if (isActive(i)) {
+                activeIndex.push_back(i);
+            } else {
+                inactiveIndex.push_back(i);
+            }
+        }
+    }
+
+    //! Makes all ocean elements active.
+    static void resetActiveElements();
+
+    //! Returns the number of active ocean elements.
+    static size_t nActiveElements() { return activeIndex.size(); }
+
     /*!
      * @brief Sets the model-wide land-ocean mask (for HField arrays).
      * @param mask The HField ModelArray containing the mask data.
@@ -250,6 +422,8 @@ private:
 
     static size_t nOcean;
     static std::vector<size_t> oceanIndex;
+    static std::vector<size_t> activeIndex;
+    static std::vector<size_t> inactiveIndex;
 };
 
 } /* namespace Nextsim */
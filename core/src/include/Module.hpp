@@ -17,6 +17,8 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 
 namespace Module {
 
@@ -111,5 +113,52 @@ template <typename I, typename M> void addToConfiguredModules()
 
 template <typename I> std::string implementation() { return Module<I>::implementation(); }
 
+/*!
+ * @brief The implementation class that is bound to an interface at compile
+ * time.
+ *
+ * @details Without a static module configuration the bound type is the
+ * interface itself, and calls are dispatched at runtime. A static module
+ * configuration (see StaticModule.hpp) specializes this for the selected
+ * interfaces, so that calls through the bound type can be inlined.
+ */
+template <typename I> struct StaticImplementation {
+    typedef I type;
+};
+
+template <typename I> using StaticImpl = typename StaticImplementation<I>::type;
+
+/*!
+ * @brief Checks that an implementation of an interface is the one bound at
+ * compile time.
+ *
+ * @details Does nothing without a static module configuration. Otherwise
+ * throws a std::runtime_error if the implementation is of any other class.
+ *
+ * @param impl The implementation to be checked.
+ */
+template <typename I> void checkStaticImplementation(const I& impl)
+{
+    if constexpr (!std::is_same_v<StaticImpl<I>, I>) {
+        if (typeid(impl) != typeid(StaticImpl<I>)) {
+            throw std::runtime_error("The implementation " + implementation<I>() + " of module "
+                + Module<I>::moduleName() + " is not the one built into the model.");
+        }
+    }
+}
+
+/*!
+ * @brief Returns an implementation as the class bound at compile time.
+ *
+ * @details The implementation must have been checked with
+ * checkStaticImplementation().
+ *
+ * @param impl The implementation to be cast.
+ */
+template <typename I> StaticImpl<I>& asStaticImplementation(I& impl)
+{
+    return static_cast<StaticImpl<I>&>(impl);
+}
+
 }
 #endif /* MODULE_HPP */
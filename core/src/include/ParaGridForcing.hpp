@@ -0,0 +1,200 @@
+/*!
+ * @file ParaGridForcing.hpp
+ *
+ * @date Oct 16, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#ifndef PARAGRIDFORCING_HPP
+#define PARAGRIDFORCING_HPP
+
+#include "include/ModelState.hpp"
+#include "include/Time.hpp"
+
+#include <future>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ncFile.h>
+#include <ncVar.h>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * A class to read forcing fields from a ParametricGrid flavoured file over
+ * the course of a model run.
+ *
+ * The file and the variables of the forcing fields are held open for the
+ * lifetime of the object, and the time axis is read once on construction.
+ * The fields are only read from the file when the record required for a
+ * given time differs from the last one read.
+ *
+ * Optionally, the record following the one just read can be prefetched into a
+ * second buffer on a background thread, while the model computes with the
+ * current record. When the time reaches the prefetched record, the buffers
+ * are swapped rather than reading the file.
+ *
+ * Also optionally, the two records bracketing the requested time can be held
+ * in memory, and the forcing fields linearly interpolated between them. The
+ * file is then only read when the time crosses a record boundary.
+ */
+class ParaGridForcing {
+public:
+    /*!
+     * @brief Opens a forcing file and reads its time axis.
+     *
+     * @param forcings The names of the forcing fields to be read.
+     * @param filePath The path of the file to read.
+     */
+    ParaGridForcing(const std::set<std::string>& forcings, const std::string& filePath);
+    ~ParaGridForcing();
+
+    //! Returns the path of the file being read.
+    const std::string& filePath() const { return m_filePath; }
+    //! Returns the names of the forcing fields being read.
+    const std::set<std::string>& forcings() const { return m_forcings; }
+
+    //! Returns the number of time records in the file.
+    size_t nRecords() const { return m_times.size(); }
+    //! Returns the time of the given record.
+    const TimePoint& recordTime(size_t record) const { return m_times.at(record); }
+    /*!
+     * @brief Returns the index of the last record at or before the given time.
+     *
+     * @details Times before the first record return the first record. The
+     * search is a binary search of the cached time axis.
+     *
+     * @param time The time to search for.
+     */
+    size_t recordIndex(const TimePoint& time) const;
+
+    /*!
+     * @brief Reads the forcing fields of a record from the file.
+     *
+     * @details The fields are read into HFields in the given ModelState,
+     * which are created or resized as required.
+     *
+     * @param record The index of the record to be read.
+     * @param state The ModelState to hold the forcing fields.
+     */
+    void readRecord(size_t record, ModelState& state) const;
+
+    /*!
+     * @brief Updates the held forcing fields to those valid at the given time.
+     *
+     * @details Returns true if the held fields have changed, and false if they
+     * were already those for the given time. Without interpolation, the fields
+     * only change when a new record is read from the file. With interpolation,
+     * they also change when the interpolation weight changes.
+     *
+     * @param time The time for which to get the forcings.
+     */
+    bool update(const TimePoint& time);
+
+    /*!
+     * @brief Sets whether the following record is read in the background.
+     *
+     * @details When set, each update that reads a new record also starts a
+     * read of the next record into a second buffer, which is swapped in by
+     * the update that requires it.
+     *
+     * @param doPrefetch Whether to prefetch the following record.
+     */
+    void setPrefetch(bool doPrefetch) { m_prefetch = doPrefetch; }
+    //! Returns whether the following record is read in the background.
+    bool prefetch() const { return m_prefetch; }
+
+    /*!
+     * @brief Sets whether the forcing fields are interpolated in time.
+     *
+     * @details When set, the fields are linearly interpolated between the
+     * last record at or before the time and the following record. Times
+     * outside the span of the file take the fields of the first or last
+     * record.
+     *
+     * @param doInterpolate Whether to interpolate between records.
+     */
+    void setInterpolate(bool doInterpolate);
+    //! Returns whether the forcing fields are interpolated in time.
+    bool interpolate() const { return m_interpolate; }
+
+    /*!
+     * @brief Writes a forcing field directly into an external array.
+     *
+     * @details Once bound, each update that changes the field writes it into
+     * the given array rather than into the held state. When interpolating,
+     * the blend of the bracketing records is written straight into the
+     * array, without an intermediate copy. The array must outlive this object.
+     *
+     * @param varName The name of the forcing field.
+     * @param target The array to receive the field.
+     */
+    void bind(const std::string& varName, ModelArray& target);
+
+    //! Returns the held forcing fields. Fields bound to an external array are
+    //! only held here when not interpolating.
+    const ModelState& state() const { return m_state; }
+    //! Returns the index of the held record, or of the earlier bracketing
+    //! record when interpolating.
+    size_t currentRecord() const { return m_record; }
+
+    //! The record index when no record has yet been read.
+    static const size_t noRecord = std::numeric_limits<size_t>::max();
+
+    /*!
+     * @brief The mutex serializing access to the NetCDF library.
+     *
+     * @details The NetCDF library is not thread safe, so any file access
+     * which might run at the same time as a background read of a forcing
+     * record must hold this lock.
+     */
+    static std::mutex& netCDFMutex();
+
+private:
+    ParaGridForcing() = delete;
+    ParaGridForcing(const ParaGridForcing& other) = delete;
+    ParaGridForcing& operator=(const ParaGridForcing& other) = delete;
+
+    // Creates or resizes the forcing arrays in a ModelState
+    void allocate(ModelState& state) const;
+    // Reads a record into the already allocated arrays of a ModelState
+    void readData(size_t record, ModelState& state) const;
+    // Waits for any background read to finish
+    void waitForPrefetch();
+    // Swaps the forcing arrays between two ModelStates
+    void swapArrays(ModelState& a, ModelState& b) const;
+    // Gets a record into a ModelState, from the prefetch buffer if possible
+    void fetch(size_t record, ModelState& state);
+    // Starts a background read of a record, if prefetching is enabled
+    void startPrefetch(size_t record);
+    // The array to which a forcing field is written by update
+    ModelArray& output(const std::string& varName);
+
+    std::string m_filePath;
+    std::set<std::string> m_forcings;
+
+    netCDF::NcFile m_file;
+    std::map<std::string, netCDF::NcVar> m_vars;
+    std::vector<TimePoint> m_times;
+
+    ModelState m_state;
+    size_t m_record;
+    std::map<std::string, ModelArray*> m_targets;
+
+    bool m_prefetch;
+    ModelState m_nextState;
+    size_t m_nextRecord;
+    std::future<void> m_pending;
+
+    bool m_interpolate;
+    ModelState m_lower;
+    ModelState m_upper;
+    double m_weight;
+};
+
+} /* namespace Nextsim */
+
+#endif /* PARAGRIDFORCING_HPP */
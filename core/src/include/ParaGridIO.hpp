@@ -8,9 +8,11 @@
 #ifndef PARAGRIDIO_HPP
 #define PARAGRIDIO_HPP
 
+#include "include/ParaGridForcing.hpp"
 #include "include/ParametricGrid.hpp"
 
 #include <map>
+#include <memory>
 #include <ncFile.h>
 #include <string>
 
@@ -73,13 +75,26 @@ public:
         const ModelState& state, const ModelMetadata& meta, const std::string& filePath) override;
 
     /*!
-     * Closes an open diagnostic file. Does nothing when provided with a
-     * restart file name.
+     * Closes an open diagnostic or forcing file. Does nothing when provided
+     * with a restart file name.
      *
      * @param filePath The path to the file to be closed.
      */
     static void close(const std::string& filePath);
 
+    /*!
+     * @brief Reads forcings from a ParameticGrid flavoured file.
+     *
+     * @details The file is held open between calls, and the forcing fields
+     * are only read from the file when the time falls in a different record
+     * to the previous call. Components that read forcings every timestep
+     * should hold their own ParaGridForcing object, which avoids the copy of
+     * the fields into the returned ModelState.
+     *
+     * @param forcings The names of the forcings required.
+     * @param time The time for which to get the forcings.
+     * @param filePath Path to the file to read.
+     */
     static ModelState readForcingTimeStatic(
         const std::set<std::string>& forcings, const TimePoint& time, const std::string& filePath);
 
@@ -103,6 +118,8 @@ private:
     // class instance, so they are static.
     static std::map<std::string, netCDF::NcFile> openFiles;
     static std::map<std::string, size_t> timeIndexByFile;
+    // Forcing files held open for reading by readForcingTimeStatic
+    static std::map<std::string, std::unique_ptr<ParaGridForcing>> forcingFiles;
 };
 
 } /* namespace Nextsim */
@@ -14,6 +14,7 @@
 #include "include/IDynamics.hpp"
 #include "include/IOceanBoundary.hpp"
 #include "include/IceGrowth.hpp"
+#include "include/TaskGraph.hpp"
 #include "include/Time.hpp"
 
 namespace Nextsim {
@@ -28,7 +29,12 @@ public:
     PrognosticData();
     virtual ~PrognosticData() = default;
 
+    enum {
+        DYNAMICS_SUBSTEPS_KEY,
+        CONCURRENT_KEY,
+    };
     void configure() override;
+    ConfigMap getConfiguration() const override;
 
     std::string getName() const override { return "PrognosticData"; };
 
@@ -51,6 +57,15 @@ public:
     /*!
      *  @brief Updates the state of the prognostic data for this timestep
      *
+     *  @details The forcing and the ice thermodynamics are calculated once
+     *  per timestep. The dynamics can be sub-cycled with a number of shorter
+     *  substeps within each timestep, using the forcing of the full timestep.
+     *  The thermodynamics then starts from the ice state left by the last
+     *  dynamics substep. If so configured, stages of the timestep which do
+     *  not depend on each other, such as the atmosphere forcing and the ocean
+     *  boundary, are run concurrently. Reads from NetCDF files still take the
+     *  NetCDF lock one at a time.
+     *
      *  @param tsInitialTime the time at the start of the timestep
      */
     void update(const TimestepTime& tsTime);
@@ -73,6 +88,12 @@ private:
     ZField m_tice;
     HField m_snow;
     double m_dt;
+    // The number of dynamics substeps in each timestep
+    int nDynamicsSubsteps = 1;
+    // Run independent stages of the timestep at the same time
+    bool concurrentStages = false;
+    // The stages of the timestep and the arrays each reads and writes
+    TaskGraph stages;
 
     IAtmosphereBoundary* pAtmBdy;
     IOceanBoundary* pOcnBdy;
@@ -80,6 +101,8 @@ private:
     IceGrowth iceGrowth;
 
     void updatePrognosticFields();
+    void updateDynamics(const TimestepTime& tst);
+    void buildStages();
 };
 
 } /* namespace Nextsim */
@@ -0,0 +1,24 @@
+/*!
+ * @file StaticModule.hpp
+ *
+ * @date Oct 17, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#ifndef STATICMODULE_HPP
+#define STATICMODULE_HPP
+
+#include "include/Module.hpp"
+
+/*
+ * When the model is built with a static module configuration, CMake generates
+ * a header which includes the selected implementations and specializes
+ * Module::StaticImplementation for their interfaces. Include this header
+ * after all other headers, and only in source files, to avoid include cycles
+ * through the implementation headers.
+ */
+#ifdef USE_STATIC_MODULES
+#include "StaticModuleSelection.hpp"
+#endif
+
+#endif /* STATICMODULE_HPP */
@@ -0,0 +1,109 @@
+/*!
+ * @file TaskGraph.hpp
+ *
+ * @date Oct 17, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#ifndef TASKGRAPH_HPP
+#define TASKGRAPH_HPP
+
+#include "include/ModelComponent.hpp"
+#include "include/Time.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class for running the stages of a timestep in dependency order.
+ *
+ * @details Each task declares the protected and shared arrays that it reads
+ * and writes. A task depends on every earlier task that writes an array it
+ * reads or writes, or that reads an array it writes. Tasks are always run in
+ * an order consistent with the order in which they were added. When run
+ * concurrently, each task starts on a pool of worker threads as soon as all
+ * the tasks it depends on have finished, so tasks with no dependency between
+ * them can run at the same time. The pool is created by the first concurrent
+ * run and reused by the later ones.
+ */
+class TaskGraph {
+public:
+    typedef std::function<void(const TimestepTime&)> Task;
+
+    //! An identifier for a protected or shared array.
+    class Field {
+    public:
+        Field(ModelComponent::ProtectedArray p)
+            : index(static_cast<size_t>(p))
+        {
+        }
+        Field(ModelComponent::SharedArray s)
+            : index(static_cast<size_t>(ModelComponent::ProtectedArray::COUNT)
+                + static_cast<size_t>(s))
+        {
+        }
+        size_t index;
+    };
+
+    TaskGraph();
+    ~TaskGraph();
+
+    /*!
+     * @brief Adds a task after all the tasks already in the graph.
+     *
+     * @param name The name of the task.
+     * @param task The task to be run, taking the timestep times.
+     * @param reads The arrays read by the task.
+     * @param writes The arrays written by the task.
+     */
+    void addTask(const std::string& name, Task task, std::initializer_list<Field> reads,
+        std::initializer_list<Field> writes);
+
+    //! Removes all the tasks from the graph.
+    void clear();
+
+    /*!
+     * @brief Runs all the tasks in the graph.
+     *
+     * @details If any task throws an exception, the tasks depending on it are
+     * not run and the first such exception is rethrown once all the other
+     * tasks have finished. A graph must not be run on several threads at once.
+     *
+     * @param tst The timestep times passed to each task.
+     * @param concurrent Run independent tasks concurrently if true, or run
+     *                   all the tasks in order on the calling thread if false.
+     */
+    void run(const TimestepTime& tst, bool concurrent) const;
+
+    //! Returns the number of tasks in the graph.
+    size_t size() const { return tasks.size(); }
+    //! Returns the name of a task.
+    const std::string& name(size_t iTask) const { return tasks[iTask].name; }
+    //! Returns the indices of the earlier tasks that a task depends on.
+    const std::vector<size_t>& dependencies(size_t iTask) const { return tasks[iTask].deps; }
+
+private:
+    struct TaskData {
+        std::string name;
+        Task task;
+        std::vector<bool> reads;
+        std::vector<bool> writes;
+        std::vector<size_t> deps;
+        // The later tasks which depend on this one
+        std::vector<size_t> dependents;
+    };
+    std::vector<TaskData> tasks;
+
+    class WorkerPool;
+    // The worker threads of concurrent runs, kept between runs
+    mutable std::unique_ptr<WorkerPool> pool;
+};
+
+} /* namespace Nextsim */
+
+#endif /* TASKGRAPH_HPP */
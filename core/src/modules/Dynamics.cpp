@@ -10,20 +10,107 @@
 
 #include "include/gridNames.hpp"
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 
 namespace Nextsim {
 
+static const double mevpToleranceDefault = 0.;
+static const int mevpMinIterationsDefault = 1;
+static const int mevpMaxIterationsDefault = 100;
+static const bool matrixFreeDefault = false;
+static const double advectionCFLSafetyDefault = 0.;
+
+template <>
+const std::map<int, std::string> Configured<Dynamics>::keyMap = {
+    { Dynamics::MEVP_TOLERANCE_KEY, "Dynamics.mevpTolerance" },
+    { Dynamics::MEVP_MIN_ITERATIONS_KEY, "Dynamics.mevpMinIterations" },
+    { Dynamics::MEVP_MAX_ITERATIONS_KEY, "Dynamics.mevpMaxIterations" },
+    { Dynamics::MATRIX_FREE_KEY, "Dynamics.matrixFree" },
+    { Dynamics::ADVECTION_CFL_SAFETY_KEY, "Dynamics.advectionCFLSafety" },
+};
+
 static const std::vector<std::string> namedFields = { hiceName, ciceName, uName, vName };
 Dynamics::Dynamics()
     : IDynamics()
+    , mevpTolerance(mevpToleranceDefault)
+    , mevpMinIterations(mevpMinIterationsDefault)
+    , mevpMaxIterations(mevpMaxIterationsDefault)
+    , matrixFree(matrixFreeDefault)
+    , advectionCFLSafety(advectionCFLSafetyDefault)
 {
     registerProtectedArray(ProtectedArray::ICE_U, &uice);
     registerProtectedArray(ProtectedArray::ICE_V, &vice);
 }
 
+void Dynamics::configure()
+{
+    mevpTolerance = Configured::getConfiguration(keyMap.at(MEVP_TOLERANCE_KEY), mevpToleranceDefault);
+    mevpMinIterations = Configured::getConfiguration(
+        keyMap.at(MEVP_MIN_ITERATIONS_KEY), mevpMinIterationsDefault);
+    mevpMaxIterations = Configured::getConfiguration(
+        keyMap.at(MEVP_MAX_ITERATIONS_KEY), mevpMaxIterationsDefault);
+    if (mevpMinIterations < 1 || mevpMaxIterations < mevpMinIterations) {
+        throw std::invalid_argument(keyMap.at(MEVP_MIN_ITERATIONS_KEY) + " and "
+            + keyMap.at(MEVP_MAX_ITERATIONS_KEY) + " must satisfy 1 ≤ min ≤ max, not "
+            + std::to_string(mevpMinIterations) + " and " + std::to_string(mevpMaxIterations));
+    }
+    kernel.setmEVPIterations(mevpTolerance, mevpMinIterations, mevpMaxIterations);
+    matrixFree = Configured::getConfiguration(keyMap.at(MATRIX_FREE_KEY), matrixFreeDefault);
+    kernel.setMatrixFree(matrixFree);
+    advectionCFLSafety = Configured::getConfiguration(
+        keyMap.at(ADVECTION_CFL_SAFETY_KEY), advectionCFLSafetyDefault);
+    if (advectionCFLSafety < 0) {
+        throw std::invalid_argument(keyMap.at(ADVECTION_CFL_SAFETY_KEY)
+            + " must not be negative, not " + std::to_string(advectionCFLSafety));
+    }
+    kernel.setAdvectionCFLSafety(advectionCFLSafety);
+}
+
+ConfigMap Dynamics::getConfiguration() const
+{
+    return {
+        { keyMap.at(MEVP_TOLERANCE_KEY), mevpTolerance },
+        { keyMap.at(MEVP_MIN_ITERATIONS_KEY), mevpMinIterations },
+        { keyMap.at(MEVP_MAX_ITERATIONS_KEY), mevpMaxIterations },
+        { keyMap.at(MATRIX_FREE_KEY), matrixFree },
+        { keyMap.at(ADVECTION_CFL_SAFETY_KEY), advectionCFLSafety },
+    };
+}
+
+Dynamics::HelpMap& Dynamics::getHelpText(HelpMap& map, bool)
+{
+    map["Dynamics"] = {
+        { keyMap.at(MEVP_TOLERANCE_KEY), ConfigType::NUMERIC, { "0", "∞" },
+            std::to_string(mevpToleranceDefault), "m s⁻¹",
+            "The mEVP iteration stops once the largest change in the ice velocity components "
+            "in one iteration is below this value. Zero always runs the maximum number of "
+            "iterations." },
+        { keyMap.at(MEVP_MIN_ITERATIONS_KEY), ConfigType::INTEGER, { "1", "∞" },
+            std::to_string(mevpMinIterationsDefault), "",
+            "The minimum number of mEVP iterations in each dynamics timestep." },
+        { keyMap.at(MEVP_MAX_ITERATIONS_KEY), ConfigType::INTEGER, { "1", "∞" },
+            std::to_string(mevpMaxIterationsDefault), "",
+            "The maximum number of mEVP iterations in each dynamics timestep." },
+        { keyMap.at(MATRIX_FREE_KEY), ConfigType::BOOLEAN, { "true", "false" },
+            matrixFreeDefault ? "true" : "false", "",
+            "Compute the element matrices of the dynamics on the fly rather than storing "
+            "them. This saves memory on large or irregular meshes." },
+        { keyMap.at(ADVECTION_CFL_SAFETY_KEY), ConfigType::NUMERIC, { "0", "∞" },
+            std::to_string(advectionCFLSafetyDefault), "",
+            "The advection of each timestep is split into the fewest sub-steps for which "
+            "the Courant number stays below this fraction of the stability limit of the "
+            "advection scheme. Zero always advects in a single step." },
+    };
+    return map;
+}
+Dynamics::HelpMap& Dynamics::getHelpRecursive(HelpMap& map, bool getAll)
+{
+    return getHelpText(map, getAll);
+}
+
 void Dynamics::setData(const ModelState::DataMap& ms)
 {
     IDynamics::setData(ms);
@@ -38,8 +38,9 @@ template<> HelpMap& getHelpRecursive<Nextsim::IDynamics>(HelpMap& map, bool getA
 {
     const std::string& pfx = Nextsim::ConfiguredModule::MODULE_PREFIX;
     map[pfx].push_back({ pfx + "." + Module<Nextsim::IDynamics>::moduleName(), ConfigType::MODULE,
-        { DUMMYDYNAMICS }, DUMMYDYNAMICS, "",
+        { DUMMYDYNAMICS, DYNAMICS }, DUMMYDYNAMICS, "",
         "MODULE DESCRIPTION HERE" });
+    Nextsim::Dynamics::getHelpRecursive(map, getAll);
     return map;
 }
 template <>
@@ -12,21 +12,42 @@
 #include "IDynamics.hpp"
 
 #include "../../../../dynamics/src/include/DynamicsKernel.hpp"
+#include "include/Configured.hpp"
 #include "include/ModelArray.hpp"
 #include "include/ModelComponent.hpp"
 
 namespace Nextsim {
-class Dynamics : public IDynamics {
+class Dynamics : public IDynamics, public Configured<Dynamics> {
 public:
     Dynamics();
 
+    enum {
+        MEVP_TOLERANCE_KEY,
+        MEVP_MIN_ITERATIONS_KEY,
+        MEVP_MAX_ITERATIONS_KEY,
+        MATRIX_FREE_KEY,
+        ADVECTION_CFL_SAFETY_KEY,
+    };
+
     std::string getName() const override { return "Dynamics"; }
     void update(const TimestepTime& tst) override;
 
     void setData(const ModelState::DataMap&) override;
+
+    void configure() override;
+    ConfigMap getConfiguration() const override;
+
+    static HelpMap& getHelpText(HelpMap& map, bool getAll);
+    static HelpMap& getHelpRecursive(HelpMap& map, bool getAll);
 private:
     // TODO: How to get the template parameters here?
     DynamicsKernel<2, 6> kernel;
+
+    double mevpTolerance;
+    int mevpMinIterations;
+    int mevpMaxIterations;
+    bool matrixFree;
+    double advectionCFLSafety;
 };
 }
 
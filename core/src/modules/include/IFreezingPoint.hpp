@@ -8,6 +8,8 @@
 #ifndef SRC_INCLUDE_IFREEZINGPOINT_HPP_
 #define SRC_INCLUDE_IFREEZINGPOINT_HPP_
 
+#include "include/ModelArray.hpp"
+
 namespace Nextsim {
 
 //! The interface class for calculation of the freezing point of seawater.
@@ -25,6 +27,25 @@ public:
      * @param sss Sea surface salinity [PSU]
      */
     virtual double operator()(double sss) const = 0;
+
+    /*!
+     * @brief A virtual function that calculates the freezing point of
+     * seawater over a whole field.
+     *
+     * @details The default implementation evaluates the single value
+     * function element by element. Implementations should override this with
+     * an array expression that the compiler can vectorize.
+     *
+     * @param sss Sea surface salinity [PSU]
+     * @param tf The array to be filled with the freezing point [˚C]
+     */
+    virtual void operator()(const ModelArray& sss, ModelArray& tf) const
+    {
+        tf = sss;
+        for (size_t i = 0; i < tf.size(); ++i) {
+            tf[i] = (*this)(sss[i]);
+        }
+    }
 };
 }
 #endif /* SRC_INCLUDE_IFREEZINGPOINT_HPP_ */
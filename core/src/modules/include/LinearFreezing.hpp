@@ -32,6 +32,17 @@ public:
         // μ is positive, so a negative sign is needed so that the freezing point is below zero.
         return -Water::mu * sss;
     }
+
+    /*!
+     * @brief Calculates the freezing point of seawater over a whole field.
+     *
+     * @param sss Sea surface salinity [PSU]
+     * @param tf The array to be filled with the freezing point [˚C]
+     */
+    inline void operator()(const ModelArray& sss, ModelArray& tf) const override
+    {
+        tf = -Water::mu * sss;
+    }
 };
 }
 
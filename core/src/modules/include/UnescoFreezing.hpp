@@ -28,15 +28,31 @@ public:
      */
     inline double operator()(double sss) const override
     {
-        // Fofonoff and Millard, Unesco technical papers in marine science 44, (1983)
-        const double a0 = -0.0575;
-        const double a1 = +1.710523e-3;
-        const double a2 = -2.154996e-4;
-        const double b = -7.53e-4;
-        const double p0 = 0; // Zero hydrostatic pressure
-
         return sss * (a0 + a1 * std::sqrt(sss) + a2 * sss) + b * p0;
     }
+
+    /*!
+     * @brief Calculates the freezing point of seawater over a whole field.
+     *
+     * @details The whole field is evaluated in a single pass with a
+     * vectorized square root.
+     *
+     * @param sss Sea surface salinity [PSU]
+     * @param tf The array to be filled with the freezing point [˚C]
+     */
+    inline void operator()(const ModelArray& sss, ModelArray& tf) const override
+    {
+        const ModelArray::DataType& s = sss.data();
+        tf = makeModelArrayExpression(sss, s * (a0 + a1 * s.sqrt() + a2 * s) + b * p0);
+    }
+
+private:
+    // Fofonoff and Millard, Unesco technical papers in marine science 44, (1983)
+    static constexpr double a0 = -0.0575;
+    static constexpr double a1 = +1.710523e-3;
+    static constexpr double a2 = -2.154996e-4;
+    static constexpr double b = -7.53e-4;
+    static constexpr double p0 = 0; // Zero hydrostatic pressure
 };
 }
 
@@ -41,6 +41,11 @@ template <> void setImplementation<ITest>(const std::string& implName)
 {
     setImplTemplate<ITestModule>(implName);
 };
+
+// Bind Impl1 at compile time, as a static module configuration would
+template <> struct StaticImplementation<ITest> {
+    typedef Impl1 type;
+};
 }
 
 namespace Nextsim {
@@ -124,6 +129,20 @@ TEST_CASE("Configure a module with an incorrect name")
     REQUIRE_THROWS(ConfiguredModule::parseConfigurator());
 
 }
+
+TEST_CASE("Static module implementation")
+{
+    Module::setImplementation<ITest>("Impl1");
+    ITest& impl1 = Module::getImplementation<ITest>();
+    REQUIRE_NOTHROW(Module::checkStaticImplementation(impl1));
+    Impl1& bound = Module::asStaticImplementation(impl1);
+    REQUIRE(bound() == 1);
+
+    // Any other implementation does not match the one bound at compile time
+    Module::setImplementation<ITest>("Impl2");
+    REQUIRE_THROWS_AS(
+        Module::checkStaticImplementation(Module::getImplementation<ITest>()), std::runtime_error);
+}
 TEST_SUITE_END();
 
 }
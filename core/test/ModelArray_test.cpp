@@ -10,6 +10,8 @@
 
 #include "include/ModelArray.hpp"
 
+#include <chrono>
+
 namespace Nextsim {
 
 TEST_SUITE_BEGIN("ModelArray");
@@ -247,6 +249,186 @@ TEST_CASE("Arithmetic tests")
     REQUIRE(fill[1] == filldub);
 }
 
+// Test that arithmetic on expiring ModelArrays reuses their data buffers
+TEST_CASE("Move semantics and allocation-free arithmetic")
+{
+    const size_t n = 5;
+    ModelArray::setDimensions(ModelArray::Type::ONED, { n });
+    OneDField lhs;
+    OneDField rhs;
+    for (size_t i = 0; i < n; ++i) {
+        lhs[i] = 2. * (i + 1);
+        rhs[i] = -1. * (i + 1);
+    }
+
+    // Moving transfers the buffer, rather than copying it
+    OneDField moveSource(lhs);
+    const double* sourceData = moveSource.getData();
+    OneDField moved(std::move(moveSource));
+    REQUIRE(moved.getData() == sourceData);
+    REQUIRE(moved[n - 1] == lhs[n - 1]);
+
+    // An expiring left operand is reused
+    const double* movedData = moved.getData();
+    OneDField sum = std::move(moved) + rhs;
+    REQUIRE(sum.getData() == movedData);
+    REQUIRE(sum[0] == 1.);
+    REQUIRE(sum[n - 1] == n);
+
+    // An expiring right operand is reused
+    const double* sumData = sum.getData();
+    OneDField difference = lhs - std::move(sum);
+    REQUIRE(difference.getData() == sumData);
+    REQUIRE(difference[0] == 1.);
+    REQUIRE(difference[n - 1] == n);
+
+    // Move assignment exchanges buffers
+    const double* differenceData = difference.getData();
+    OneDField target = lhs;
+    target = std::move(difference);
+    REQUIRE(target.getData() == differenceData);
+    REQUIRE(target[n - 1] == n);
+
+    // A timestep's worth of chained operations on an expiring array makes no
+    // allocations at all. The test target is built with
+    // EIGEN_RUNTIME_NO_MALLOC, where any Eigen heap allocation inside the
+    // marked region fails an assertion.
+    const double* targetData = target.getData();
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+    Eigen::internal::set_is_malloc_allowed(false);
+#endif
+    target = 4. - (1. + (-(2. * std::move(target) + rhs) * lhs / rhs - 3.)) / 2.;
+    target = 1. / std::move(target).max(0.25).min(lhs);
+    target.clampAbove(rhs);
+    target.clampBelow(1.5);
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+    Eigen::internal::set_is_malloc_allowed(true);
+#endif
+    REQUIRE(target.getData() == targetData);
+    // (2 * 1 - 1) = 1, -1 * 2 / -1 = 2, 2 - 3 = -1, 1 - 1 = 0, 4 - 0 / 2 = 4
+    // max(4, 0.25) = 4, min(4, 2) = 2, 1 / 2 = 0.5, max(0.5, -1) = 0.5, min(0.5, 1.5) = 0.5
+    REQUIRE(target[0] == 0.5);
+    // (2 * 5 - 5) = 5, -5 * 10 / -5 = 10, 10 - 3 = 7, 1 + 7 = 8, 4 - 8 / 2 = 0
+    // max(0, 0.25) = 0.25, min(0.25, 10) = 0.25, 1 / 0.25 = 4, max(4, -5) = 4, min(4, 1.5) = 1.5
+    REQUIRE(target[n - 1] == 1.5);
+}
+
+// Test that whole-array expressions are evaluated lazily, in a single pass
+TEST_CASE("Lazy expression evaluation")
+{
+    // A 1000x1000 grid, the size of a large H field
+    const size_t n = 1000;
+    ModelArray::setDimensions(ModelArray::Type::TWOD, { n, n });
+    TwoDField sss = ModelArray::TwoDField();
+    TwoDField cice = ModelArray::TwoDField();
+    TwoDField deltaIce = ModelArray::TwoDField();
+    for (size_t i = 0; i < sss.size(); ++i) {
+        sss[i] = 30. + (i % 7);
+        cice[i] = 0.1 * (i % 11);
+        deltaIce[i] = 0.01 * (i % 5) - 0.02;
+    }
+    const double dt = 600.;
+
+    // Arithmetic builds an expression without evaluating anything
+    auto iceVol = deltaIce * cice;
+    auto effectiveSal = sss.min(5.);
+    REQUIRE(iceVol.getType() == ModelArray::Type::TWOD);
+
+    // A slab ocean style update of an existing array runs as one pass over
+    // the operands, with no intermediate arrays. The test target is built
+    // with EIGEN_RUNTIME_NO_MALLOC, where any Eigen heap allocation inside
+    // the marked region fails an assertion.
+    TwoDField sssSlab = ModelArray::TwoDField();
+    const double* slabData = sssSlab.getData();
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+    Eigen::internal::set_is_malloc_allowed(false);
+#endif
+    sssSlab = sss
+        + ((sss - effectiveSal) * 917. * iceVol + (1 - cice) * dt)
+            / (1025. - iceVol * 917.).max(1000.);
+    sssSlab += -cice * sss / 100.;
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+    Eigen::internal::set_is_malloc_allowed(true);
+#endif
+    REQUIRE(sssSlab.getData() == slabData);
+
+    // Compare to the same calculation performed element by element
+    for (size_t i : { size_t(0), size_t(12345), n * n - 1 }) {
+        double vol = deltaIce[i] * cice[i];
+        double effSal = std::min(sss[i], 5.);
+        double denominator = std::max(1025. - vol * 917., 1000.);
+        double expected
+            = sss[i] + ((sss[i] - effSal) * 917. * vol + (1 - cice[i]) * dt) / denominator;
+        expected += -cice[i] * sss[i] / 100.;
+        REQUIRE(sssSlab[i] == doctest::Approx(expected).epsilon(1e-12));
+    }
+
+    // Constructing from an expression allocates exactly the result
+    TwoDField constructed = sss * cice + 1.;
+    REQUIRE(constructed.getType() == ModelArray::Type::TWOD);
+    REQUIRE(constructed.size() == n * n);
+    REQUIRE(constructed[n + 1] == sss[n + 1] * cice[n + 1] + 1.);
+}
+
+// Compares a slab ocean style update evaluated as one fused expression with
+// the same update evaluated one operator at a time, each into a new array, as
+// the arithmetic operators did before they returned expressions. The timings
+// are reported, but not tested.
+TEST_CASE("Expression evaluation microbenchmark")
+{
+    const size_t n = 1000;
+    ModelArray::setDimensions(ModelArray::Type::TWOD, { n, n });
+    TwoDField sss = ModelArray::TwoDField();
+    TwoDField cice = ModelArray::TwoDField();
+    TwoDField deltaIce = ModelArray::TwoDField();
+    for (size_t i = 0; i < sss.size(); ++i) {
+        sss[i] = 30. + (i % 7);
+        cice[i] = 0.1 * (i % 11);
+        deltaIce[i] = 0.01 * (i % 5) - 0.02;
+    }
+    const double dt = 600.;
+    TwoDField fused = ModelArray::TwoDField();
+    TwoDField temporaries = ModelArray::TwoDField();
+
+    const size_t nRepeats = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < nRepeats; ++r) {
+        fused = sss
+            + ((sss - sss.min(5.)) * 917. * (deltaIce * cice) + (1 - cice) * dt)
+                / (1025. - (deltaIce * cice) * 917.).max(1000.);
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < nRepeats; ++r) {
+        TwoDField iceVol = deltaIce * cice;
+        TwoDField effectiveSal = sss.min(5.);
+        TwoDField salDiff = sss - effectiveSal;
+        TwoDField salFlux = salDiff * 917.;
+        TwoDField iceFlux = salFlux * iceVol;
+        TwoDField openWater = 1 - cice;
+        TwoDField openFlux = openWater * dt;
+        TwoDField numerator = iceFlux + openFlux;
+        TwoDField iceMass = iceVol * 917.;
+        TwoDField waterMass = 1025. - iceMass;
+        TwoDField denominator = waterMass.max(1000.);
+        TwoDField ratio = numerator / denominator;
+        temporaries = sss + ratio;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (size_t i : { size_t(0), size_t(12345), n * n - 1 }) {
+        REQUIRE(fused[i] == doctest::Approx(temporaries[i]).epsilon(1e-12));
+    }
+    std::chrono::duration<double, std::milli> fusedTime = mid - start;
+    std::chrono::duration<double, std::milli> temporariesTime = end - mid;
+    // The fused pass reads the three operands and writes the result. Each of
+    // the 13 separate operations reads one or two arrays and writes one.
+    const double arrayMB = n * n * sizeof(double) / 1.e6;
+    MESSAGE("fused expression: " << fusedTime.count() / nRepeats << " ms, "
+                                 << 4 * arrayMB << " MB of array traffic");
+    MESSAGE("temporary arrays: " << temporariesTime.count() / nRepeats << " ms, "
+                                 << 32 * arrayMB << " MB of array traffic");
+}
+
 // Location from index. Index from location is assumed to work as it is a
 // wrapper around indexr()
 TEST_CASE("Location from index")
@@ -11,6 +11,9 @@
 #include "include/ModelArrayRef.hpp"
 #include "include/ModelComponent.hpp"
 
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <stdexcept>
 
 namespace Nextsim {
@@ -191,6 +194,206 @@ TEST_CASE("Shared and semi-protected arrays")
 
     REQUIRE(semi.data() == share.qicData);
 }
+
+// A module exposing the element iteration functions for testing
+class ModuleIterated : public ModelComponent {
+public:
+    ModuleIterated() { }
+    std::string getName() const override { return "Iterated"; }
+    void setData(const ModelState::DataMap&) override { }
+    ModelState getState() const override { return ModelState(); }
+    ModelState getState(const OutputLevel&) const override { return getState(); }
+
+    using ModelComponent::overElements;
+    using ModelComponent::parallelOverElements;
+    using ModelComponent::parallelOverElementBatches;
+    using ModelComponent::noLandMask;
+    using ModelComponent::setOceanMask;
+    // The previous implementation, calling through a std::function
+    static void overElementsFunction(IteratedFn fn, const TimestepTime& tst)
+    {
+        overElements(fn, tst);
+    }
+};
+
+TEST_CASE("Iteration over ocean elements")
+{
+    const size_t nx = 5;
+    const size_t ny = 4;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+    ModuleIterated iter;
+
+    // Land along the first row
+    HField mask(ModelArray::Type::H);
+    mask.resize();
+    mask = 1.;
+    for (size_t i = 0; i < nx; ++i) {
+        mask(i, size_t(0)) = 0.;
+    }
+    ModuleIterated::setOceanMask(mask);
+
+    HField visits(ModelArray::Type::H);
+    visits.resize();
+    visits = 0.;
+    size_t count = 0;
+    ModuleIterated::overElements(
+        [&visits, &count](size_t i, const TimestepTime&) {
+            visits[i] += 1.;
+            ++count;
+        },
+        TimestepTime());
+    // Each ocean element visited exactly once, land never
+    REQUIRE(count == nx * (ny - 1));
+    for (size_t i = 0; i < nx; ++i) {
+        REQUIRE(visits(i, 0) == 0.);
+        for (size_t j = 1; j < ny; ++j) {
+            REQUIRE(visits(i, j) == 1.);
+        }
+    }
+
+    // Restore the all-ocean mask
+    ModuleIterated::noLandMask();
+}
+
+TEST_CASE("Parallel iteration over ocean elements")
+{
+    const size_t nx = 37;
+    const size_t ny = 29;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+    ModuleIterated iter;
+
+    // Land in a checkerboard of 3x3 blocks
+    HField mask(ModelArray::Type::H);
+    mask.resize();
+    for (size_t j = 0; j < ny; ++j) {
+        for (size_t i = 0; i < nx; ++i) {
+            mask(i, j) = ((i / 3 + j / 3) % 2) ? 1. : 0.;
+        }
+    }
+    ModuleIterated::setOceanMask(mask);
+
+    HField serial(ModelArray::Type::H);
+    serial.resize();
+    serial = -1.;
+    HField parallel(ModelArray::Type::H);
+    parallel.resize();
+    parallel = -1.;
+    TimestepTime tst = { TimePoint(), Duration(600.) };
+    auto element = [](size_t i, const TimestepTime& t) {
+        return std::exp(-1e-3 * i) * t.step.seconds() / (1. + std::sqrt(i));
+    };
+    ModuleIterated::overElements(
+        [&serial, &element](size_t i, const TimestepTime& t) { serial[i] = element(i, t); }, tst);
+    ModuleIterated::parallelOverElements(
+        [&parallel, &element](size_t i, const TimestepTime& t) { parallel[i] = element(i, t); },
+        tst);
+
+    // Bit-identical results, with land untouched
+    for (size_t i = 0; i < serial.size(); ++i) {
+        REQUIRE(parallel[i] == serial[i]);
+        REQUIRE((mask[i] > 0) == (parallel[i] != -1.));
+    }
+
+    // Restore the all-ocean mask
+    ModuleIterated::noLandMask();
+}
+
+TEST_CASE("Batched iteration over ocean elements")
+{
+    const size_t nx = 37;
+    const size_t ny = 29;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+    ModuleIterated iter;
+
+    // Land in a checkerboard of 3x3 blocks
+    HField mask(ModelArray::Type::H);
+    mask.resize();
+    for (size_t j = 0; j < ny; ++j) {
+        for (size_t i = 0; i < nx; ++i) {
+            mask(i, j) = ((i / 3 + j / 3) % 2) ? 1. : 0.;
+        }
+    }
+    ModuleIterated::setOceanMask(mask);
+
+    // Count the visits to each element
+    HField visits(ModelArray::Type::H);
+    visits.resize();
+    visits = 0.;
+    static const size_t batchSize = 8;
+    TimestepTime tst = { TimePoint(), Duration(600.) };
+    ModuleIterated::parallelOverElementBatches<batchSize>(
+        [&visits](const size_t* index, size_t n, const TimestepTime&) {
+            REQUIRE(n > 0);
+            REQUIRE(n <= batchSize);
+            for (size_t l = 0; l < n; ++l) {
+                visits[index[l]] += 1.;
+            }
+        },
+        tst);
+
+    // Every ocean element exactly once, with land untouched
+    for (size_t i = 0; i < visits.size(); ++i) {
+        REQUIRE(visits[i] == ((mask[i] > 0) ? 1. : 0.));
+    }
+
+    // Restore the all-ocean mask
+    ModuleIterated::noLandMask();
+}
+
+// Compares the templated and std::function element iteration. The timings are
+// reported, but not tested.
+TEST_CASE("Element iteration microbenchmark")
+{
+    const size_t n = 1000;
+    ModelArray::setDimensions(ModelArray::Type::H, { n, n });
+    ModuleIterated iter;
+
+    HField a(ModelArray::Type::H);
+    a.resize();
+    HField b(ModelArray::Type::H);
+    b.resize();
+    HField viaFunction(ModelArray::Type::H);
+    viaFunction.resize();
+    HField viaTemplate(ModelArray::Type::H);
+    viaTemplate.resize();
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = 0.001 * i;
+        b[i] = 1. + (i % 17);
+    }
+    TimestepTime tst = { TimePoint(), Duration(600.) };
+    auto element = [&a, &b](size_t i, const TimestepTime& t) {
+        return a[i] + t.step.seconds() * std::sqrt(b[i]) / (1. + a[i] * a[i]);
+    };
+
+    const size_t nRepeats = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < nRepeats; ++r) {
+        ModuleIterated::overElementsFunction(
+            std::bind(
+                [&viaFunction, &element](size_t i, const TimestepTime& t) {
+                    viaFunction[i] = element(i, t);
+                },
+                std::placeholders::_1, std::placeholders::_2),
+            tst);
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < nRepeats; ++r) {
+        ModuleIterated::overElements(
+            [&viaTemplate, &element](size_t i, const TimestepTime& t) {
+                viaTemplate[i] = element(i, t);
+            },
+            tst);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (size_t i : { size_t(0), size_t(12345), n * n - 1 }) {
+        REQUIRE(viaTemplate[i] == viaFunction[i]);
+    }
+    std::chrono::duration<double, std::milli> functionTime = mid - start;
+    std::chrono::duration<double, std::milli> templateTime = end - mid;
+    MESSAGE("std::function iteration: " << functionTime.count() / nRepeats << " ms");
+    MESSAGE("templated iteration: " << templateTime.count() / nRepeats << " ms");
+}
 TEST_SUITE_END();
 
 } /* namespace Nextsim */
@@ -195,6 +195,29 @@ TEST_CASE("Accessing the data two ways")
     couplIn.update();
     REQUIRE(swin[0] == targetFlux);
 }
+
+TEST_CASE("Pointers to the data")
+{
+    CouplIn couplIn;
+    ModelArray::setDimensions(ModelArray::Type::H, {3, 2});
+    couplIn.configure();
+    couplIn.setData();
+    ModelArrayRef<couplFields::SWIN, MARBackingStore> swin(couplIn.bs());
+    ModelArrayRef<couplFields::SWIN, MARBackingStore, RW> swinRW(couplIn.bs());
+
+    const double* swinData = swin.getData();
+    REQUIRE(swinData == &swin[0]);
+    REQUIRE(swinData[0] == 350);
+
+    // Writes through the read-write pointer are seen through the references
+    double* swinRWData = swinRW.getData();
+    for (size_t i = 0; i < swin.data().size(); ++i) {
+        swinRWData[i] = 10. * i;
+    }
+    for (size_t i = 0; i < swin.data().size(); ++i) {
+        REQUIRE(swin[i] == 10. * i);
+    }
+}
 TEST_SUITE_END();
 
 };
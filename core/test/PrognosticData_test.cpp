@@ -19,6 +19,7 @@
 #include "include/constants.hpp"
 
 #include <sstream>
+#include <vector>
 
 extern template class Module::Module<Nextsim::IOceanBoundary>;
 
@@ -103,6 +104,63 @@ TEST_CASE("PrognosticData call order test")
     // Value if pAtmBdy->update and pOcnBdy->updateBefore are switched in PrognosticData::update
     REQUIRE(qow[0] != doctest::Approx(-92.1569).epsilon(prec));
 }
+
+TEST_CASE("Dynamics substeps")
+{
+    ModelArray::setDimensions(ModelArray::Type::H, { 1, 1 });
+    ModelArray::setDimensions(ModelArray::Type::Z, { 1, 1, 1 });
+
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "Nextsim::IAtmosphereBoundary = Nextsim::ConstantAtmosphereBoundary" << std::endl;
+    config << "Nextsim::IOceanBoundary = Nextsim::ConstantOceanBoundary" << std::endl;
+    config << std::endl;
+    config << "[PrognosticData]" << std::endl;
+    config << "dynamicsSubsteps = 4" << std::endl;
+
+    Configurator::clear();
+    std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+    Configurator::addStream(std::move(pcstream));
+
+    ConfiguredModule::parseConfigurator();
+
+    // Dynamics which records the timesteps it is called with
+    static std::vector<TimestepTime> substeps;
+    class RecordingDynamics : public IDynamics {
+    public:
+        void update(const TimestepTime& tst) override { substeps.push_back(tst); }
+        void setData(const ModelState::DataMap&) override { }
+    };
+    Module::Module<IDynamics>::setExternalImplementation(
+        Module::newImpl<IDynamics, RecordingDynamics>);
+
+    HField zeroData;
+    zeroData.resize();
+    zeroData[0] = 0.;
+    ZField zeroDataZ;
+    zeroDataZ.resize();
+    zeroDataZ[0] = 0.;
+
+    ModelState::DataMap initialData = {
+        { "cice", zeroData },
+        { "hice", zeroData },
+        { "hsnow", zeroData },
+        { "tice", zeroDataZ },
+    };
+
+    PrognosticData pData;
+    pData.configure();
+    pData.setData(initialData);
+    TimestepTime tst = { TimePoint("2000-01-01T00:00:00Z"), Duration("P0-0T0:10:0") };
+    pData.update(tst);
+
+    // Four substeps covering the whole timestep
+    REQUIRE(substeps.size() == 4);
+    for (size_t i = 0; i < substeps.size(); ++i) {
+        REQUIRE(substeps[i].step.seconds() == 150.);
+        REQUIRE(substeps[i].start == tst.start + Duration(150. * i));
+    }
+}
 TEST_SUITE_END();
 
 } /* namespace Nextsim */
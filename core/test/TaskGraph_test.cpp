@@ -0,0 +1,147 @@
+/*!
+ * @file TaskGraph_test.cpp
+ *
+ * @date Oct 17, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "include/TaskGraph.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_SUITE_BEGIN("TaskGraph");
+TEST_CASE("Dependencies")
+{
+    typedef ModelComponent::ProtectedArray P;
+    typedef ModelComponent::SharedArray S;
+    TaskGraph::Task noop = [](const TimestepTime&) {};
+
+    TaskGraph graph;
+    graph.addTask("sst", noop, {}, { P::SST });
+    graph.addTask("air", noop, {}, { P::T_AIR });
+    graph.addTask("flux", noop, { P::SST, P::T_AIR }, { S::Q_OW });
+    graph.addTask("read sst", noop, { P::SST }, {});
+    graph.addTask("new sst", noop, { S::Q_OW }, { P::SST });
+
+    REQUIRE(graph.size() == 5);
+    REQUIRE(graph.name(2) == "flux");
+    REQUIRE(graph.dependencies(0).empty());
+    REQUIRE(graph.dependencies(1).empty());
+    // Read after write
+    REQUIRE(graph.dependencies(2) == std::vector<size_t> { 0, 1 });
+    // Reads do not depend on each other
+    REQUIRE(graph.dependencies(3) == std::vector<size_t> { 0 });
+    // Write after write and write after read
+    REQUIRE(graph.dependencies(4) == std::vector<size_t> { 0, 2, 3 });
+
+    graph.clear();
+    REQUIRE(graph.size() == 0);
+}
+
+TEST_CASE("Concurrent and ordered tasks")
+{
+    typedef ModelComponent::ProtectedArray P;
+    TimestepTime tst = { TimePoint("2000-01-01T00:00:00Z"), Duration(600.) };
+
+    // Two independent tasks, each of which waits to see the other start. The
+    // wait only runs to its limit if the tasks do not overlap.
+    std::atomic<int> started(0);
+    bool sawOther[2] = { false, false };
+    std::chrono::milliseconds patience(2000);
+    auto rendezvous = [&started, &sawOther, &patience](int iTask) {
+        ++started;
+        auto giveUp = std::chrono::steady_clock::now() + patience;
+        while (started < 2 && std::chrono::steady_clock::now() < giveUp) {
+            std::this_thread::yield();
+        }
+        sawOther[iTask] = started == 2;
+    };
+    // A dependent task, which must see both results
+    bool sawBoth = false;
+    double stepSeconds = 0;
+
+    TaskGraph graph;
+    graph.addTask("first", [&rendezvous](const TimestepTime&) { rendezvous(0); }, {},
+        { P::T_AIR });
+    graph.addTask("second", [&rendezvous](const TimestepTime&) { rendezvous(1); }, {},
+        { P::SST });
+    graph.addTask(
+        "after",
+        [&sawOther, &sawBoth, &stepSeconds](const TimestepTime& t) {
+            sawBoth = sawOther[0] && sawOther[1];
+            stepSeconds = t.step.seconds();
+        },
+        { P::T_AIR, P::SST }, {});
+
+    graph.run(tst, true);
+    REQUIRE(sawBoth);
+    REQUIRE(stepSeconds == 600.);
+
+    // Run in order, the first task cannot see the second start, so need not
+    // wait for it
+    started = 0;
+    patience = std::chrono::milliseconds(0);
+    graph.run(tst, false);
+    REQUIRE(!sawOther[0]);
+    REQUIRE(sawOther[1]);
+}
+
+TEST_CASE("Worker threads are reused")
+{
+    typedef ModelComponent::ProtectedArray P;
+    TimestepTime tst = { TimePoint("2000-01-01T00:00:00Z"), Duration(600.) };
+
+    std::mutex idMutex;
+    std::set<std::thread::id> ids;
+    TaskGraph::Task record = [&idMutex, &ids](const TimestepTime&) {
+        std::lock_guard<std::mutex> lock(idMutex);
+        ids.insert(std::this_thread::get_id());
+    };
+    TaskGraph graph;
+    graph.addTask("first", record, {}, { P::T_AIR });
+    graph.addTask("second", record, {}, { P::SST });
+    graph.addTask("after", record, { P::T_AIR, P::SST }, {});
+
+    const size_t nRuns = 20;
+    for (size_t i = 0; i < nRuns; ++i) {
+        graph.run(tst, true);
+    }
+    // At most two tasks can run at once, so two threads are enough for
+    // every run
+    REQUIRE(ids.size() <= 2);
+    REQUIRE(ids.count(std::this_thread::get_id()) == 0);
+}
+
+TEST_CASE("Exceptions")
+{
+    typedef ModelComponent::ProtectedArray P;
+    TimestepTime tst = { TimePoint("2000-01-01T00:00:00Z"), Duration(600.) };
+
+    bool independentRan = false;
+    bool dependentRan = false;
+    TaskGraph graph;
+    graph.addTask("throws",
+        [](const TimestepTime&) { throw std::runtime_error("Task failed"); }, {}, { P::SST });
+    graph.addTask("independent", [&independentRan](const TimestepTime&) { independentRan = true; },
+        {}, { P::T_AIR });
+    graph.addTask("dependent", [&dependentRan](const TimestepTime&) { dependentRan = true; },
+        { P::SST }, {});
+
+    REQUIRE_THROWS_AS(graph.run(tst, true), std::runtime_error);
+    REQUIRE(independentRan);
+    REQUIRE(!dependentRan);
+}
+TEST_SUITE_END();
+
+} /* namespace Nextsim */
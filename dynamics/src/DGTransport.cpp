@@ -6,8 +6,13 @@
 
 #include "DGTransport.hpp"
 #include "Interpolations.hpp"
+#include "ParametricTools.hpp"
+#include "SumFactorisation.hpp"
 #include "codeGenerationDGinGauss.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Nextsim {
 
 
@@ -207,6 +212,32 @@ void DGTransport<DG>::reinitnormalvelocity()
              normalvel_Y.row((smesh.nx+1)*iy + ix) *= 2.0;
          }
       }
+
+    // The Courant number of each element is dt times the largest normal flux
+    // over one of its edges divided by its area. The normal velocity is
+    // already scaled with the length of the edge.
+    double rate = 0.;
+#pragma omp parallel for reduction(max : rate)
+    for (size_t eid = 0; eid < smesh.nelements; ++eid)
+      {
+	if (smesh.landmask[eid]==0)
+	  continue;
+	const size_t ix = eid % smesh.nx;
+	const size_t iy = eid / smesh.nx;
+	const double flux = std::max(
+	    std::max((normalvel_X.row(eid) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).cwiseAbs().maxCoeff(),
+		     (normalvel_X.row(eid + smesh.nx) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).cwiseAbs().maxCoeff()),
+	    std::max((normalvel_Y.row((smesh.nx+1)*iy + ix) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).cwiseAbs().maxCoeff(),
+		     (normalvel_Y.row((smesh.nx+1)*iy + ix + 1) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).cwiseAbs().maxCoeff()));
+	double size = smesh.area(eid);
+	// the length of the edges in longitude direction is scaled with the metric
+	// term, taken in the centre of the element, which overestimates the Courant number
+	// for the other edges
+	if (smesh.CoordinateSystem == SPHERICAL)
+	  size *= Nextsim::EarthRadius * cos(smesh.coordinatesOfElement(eid).col(1).mean());
+	rate = std::max(rate, flux / size);
+      }
+    courantrate = rate;
 }
 
 ////////////////////////////////////////////////// PREPARE
@@ -230,15 +261,15 @@ void DGTransport<DG>::prepareAdvection(const CGVector<CG>& cg_vx, const CGVector
 ////////////////////////////////////////////////// CELL TERM
 
 template <>
-void DGTransport<1>::cell_term(const ParametricMesh& smesh, double dt,
-    DGVector<1>& phiup, const DGVector<1>& phi,
-    const DGVector<1>& vx,
-    const DGVector<1>& vy, const size_t ic) { }
+void DGTransport<1>::cell_term(const ParametricMesh&, double,
+    const std::vector<DGVector<1>*>&, const std::vector<DGVector<1>*>&,
+    const DGVector<1>&,
+    const DGVector<1>&, const size_t) { }
 
 template <int DG>
 void DGTransport<DG>::cell_term(const ParametricMesh& smesh, double dt,
-    DGVector<DG>& phiup,
-    const DGVector<DG>& phi,
+    const std::vector<DGVector<DG>*>& phiup,
+    const std::vector<DGVector<DG>*>& phi,
     const DGVector<DG>& vx,
     const DGVector<DG>& vy, const size_t eid)
 {
@@ -251,46 +282,78 @@ void DGTransport<DG>::cell_term(const ParametricMesh& smesh, double dt,
   }
   const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> vx_gauss = vx.row(eid) * PSI<DG, GAUSSPOINTS1D(DG)>; //!< velocity in GP
   const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> vy_gauss = vy.row(eid) * PSI<DG, GAUSSPOINTS1D(DG)>;
-  const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> phi_gauss = (phi.row(eid) * PSI<DG, GAUSSPOINTS1D(DG)>).array();
-  
-  phiup.row(eid) += dt * (parammap.AdvectionCellTermX[eid].array().rowwise() * vx_gauss.array() + parammap.AdvectionCellTermY[eid].array().rowwise() * vy_gauss.array()).matrix() * phi_gauss.transpose();
+
+  if (parammap.matrixfree)
+    {
+      // (v phi, J dT^{-T} nabla psi) with the transformation computed on the fly
+      const SumFactorisation::ElementGeometry<GAUSSPOINTS1D(DG)> geo(smesh, eid);
+      for (size_t it = 0; it < phi.size(); ++it)
+	{
+	  const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> phi_gauss = phi[it]->row(eid) * PSI<DG, GAUSSPOINTS1D(DG)>;
+	  const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> vxphi = vx_gauss.cwiseProduct(phi_gauss);
+	  Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> vyphi = vy_gauss.cwiseProduct(phi_gauss);
+	  //! the lat-direction must be scaled with the metric term if in the spherical system
+	  if (smesh.CoordinateSystem == SPHERICAL)
+	    vyphi = vyphi.cwiseProduct(geo.cos_lat);
+	  phiup[it]->row(eid) += dt * SumFactorisation::integrateDGGradient<DG, GAUSSPOINTS1D(DG)>(
+	      geo.Fy.row(1).cwiseProduct(vxphi) - geo.Fy.row(0).cwiseProduct(vyphi),
+	      geo.Fx.row(0).cwiseProduct(vyphi) - geo.Fx.row(1).cwiseProduct(vxphi)).transpose();
+	}
+      return;
+    }
+
+  // (v . nabla psi_i)(q), the same for all tracers
+  const Eigen::Matrix<Nextsim::FloatType, DG, GAUSSPOINTS(DG)> vgradpsi = (parammap.AdvectionCellTermX[eid].array().rowwise() * vx_gauss.array() + parammap.AdvectionCellTermY[eid].array().rowwise() * vy_gauss.array()).matrix();
+  for (size_t it = 0; it < phi.size(); ++it)
+    {
+      const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> phi_gauss = (phi[it]->row(eid) * PSI<DG, GAUSSPOINTS1D(DG)>).array();
+      phiup[it]->row(eid) += dt * vgradpsi * phi_gauss.transpose();
+    }
 }
 ////////////////////////////////////////////////// BOUNDARY HANDLING
 
 
 template <int DG>
-void boundary_lower(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup,
-    const DGVector<DG>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_X, const size_t c, const size_t e)
+void boundary_lower(const double dt, const std::vector<DGVector<DG>*>& phiup,
+    const std::vector<DGVector<DG>*>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_X, const size_t c, const size_t e)
 {
     // GP = DGEDGE
     LocalEdgeVector<EDGEDOFS(DG)> vel_gauss = normalvel_X.row(e) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>;
     // block<1, 2>(e, 0) * PSIe<2,2>;
-    LocalEdgeVector<EDGEDOFS(DG)> tmp = ((bottomedgeofcell<DG>(phi, c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (-vel_gauss.array()).max(0));
-    phiup.row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 0>;
+    for (size_t it = 0; it < phi.size(); ++it) {
+        LocalEdgeVector<EDGEDOFS(DG)> tmp = ((bottomedgeofcell<DG>(*phi[it], c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (-vel_gauss.array()).max(0));
+        phiup[it]->row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 0>;
+    }
 }
 template <int DG>
-void boundary_upper(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup,
-    const DGVector<DG>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_X, const size_t c, const size_t e)
+void boundary_upper(const double dt, const std::vector<DGVector<DG>*>& phiup,
+    const std::vector<DGVector<DG>*>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_X, const size_t c, const size_t e)
 {
     LocalEdgeVector<EDGEDOFS(DG)> vel_gauss = normalvel_X.row(e) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>;
-    LocalEdgeVector<EDGEDOFS(DG)> tmp = ((topedgeofcell<DG>(phi, c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (vel_gauss.array()).max(0));
-    phiup.row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 2>;
+    for (size_t it = 0; it < phi.size(); ++it) {
+        LocalEdgeVector<EDGEDOFS(DG)> tmp = ((topedgeofcell<DG>(*phi[it], c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (vel_gauss.array()).max(0));
+        phiup[it]->row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 2>;
+    }
 }
 template <int DG>
-void boundary_left(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup,
-    const DGVector<DG>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c, const size_t e)
+void boundary_left(const double dt, const std::vector<DGVector<DG>*>& phiup,
+    const std::vector<DGVector<DG>*>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c, const size_t e)
 {
     LocalEdgeVector<EDGEDOFS(DG)> vel_gauss = normalvel_Y.row(e) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>;
-    LocalEdgeVector<EDGEDOFS(DG)> tmp = ((leftedgeofcell<DG>(phi, c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (-vel_gauss.array()).max(0));
-    phiup.row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 3>;
+    for (size_t it = 0; it < phi.size(); ++it) {
+        LocalEdgeVector<EDGEDOFS(DG)> tmp = ((leftedgeofcell<DG>(*phi[it], c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (-vel_gauss.array()).max(0));
+        phiup[it]->row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 3>;
+    }
 }
 template <int DG>
-void boundary_right(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup,
-    const DGVector<DG>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c, const size_t e)
+void boundary_right(const double dt, const std::vector<DGVector<DG>*>& phiup,
+    const std::vector<DGVector<DG>*>& phi, const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c, const size_t e)
 {
     LocalEdgeVector<EDGEDOFS(DG)> vel_gauss = normalvel_Y.row(e) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>;
-    LocalEdgeVector<EDGEDOFS(DG)> tmp = ((rightedgeofcell<DG>(phi, c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (vel_gauss.array().max(0)));
-    phiup.row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 1>;
+    for (size_t it = 0; it < phi.size(); ++it) {
+        LocalEdgeVector<EDGEDOFS(DG)> tmp = ((rightedgeofcell<DG>(*phi[it], c) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() * (vel_gauss.array().max(0)));
+        phiup[it]->row(c) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 1>;
+    }
 }
 
 
@@ -298,36 +361,42 @@ void boundary_right(const ParametricMesh& smesh, const double dt, DGVector<DG>&
 ////////////////////////////////////////////////// EDGE TERMS
 
 template<>
-inline void DGTransport<1>::edge_term_X(const ParametricMesh& smesh, const double dt, DGVector<1>& phiup, const DGVector<1>& phi, // DG0 (1)
+inline void DGTransport<1>::edge_term_X(const ParametricMesh& smesh, const double dt, const std::vector<DGVector<1>*>& phiup, const std::vector<DGVector<1>*>& phi, // DG0 (1)
 					       const EdgeVector<1>& normalvel_X, const size_t c1, const size_t c2, const size_t ie)
 {
   if (smesh.landmask[c1]==0) return;
   if (smesh.landmask[c2]==0) return;
   
-    double bottom = phi(c1, 0);
-    double top = phi(c2, 0);
     double vel = normalvel_X(ie, 0);
 
-    phiup(c1, 0) -= dt * (std::max(vel, 0.) * bottom + std::min(vel, 0.) * top);
-    phiup(c2, 0) += dt * (std::max(vel, 0.) * bottom + std::min(vel, 0.) * top);
+    for (size_t it = 0; it < phi.size(); ++it) {
+        double bottom = (*phi[it])(c1, 0);
+        double top = (*phi[it])(c2, 0);
+
+        (*phiup[it])(c1, 0) -= dt * (std::max(vel, 0.) * bottom + std::min(vel, 0.) * top);
+        (*phiup[it])(c2, 0) += dt * (std::max(vel, 0.) * bottom + std::min(vel, 0.) * top);
+    }
 }
 template<>
-inline void DGTransport<1>::edge_term_Y(const ParametricMesh& smesh, const double dt, DGVector<1>& phiup, const DGVector<1>& phi, // DG0 (1)
+inline void DGTransport<1>::edge_term_Y(const ParametricMesh& smesh, const double dt, const std::vector<DGVector<1>*>& phiup, const std::vector<DGVector<1>*>& phi, // DG0 (1)
     const EdgeVector<1>& normalvel_Y, const size_t c1, const size_t c2, const size_t ie)
 {
   if (smesh.landmask[c1]==0) return;
   if (smesh.landmask[c2]==0) return;
   
-    double left = phi(c1, 0);
-    double right = phi(c2, 0);
     double vel = normalvel_Y(ie, 0);
 
-    phiup(c1, 0) -= dt * (std::max(vel, 0.) * left + std::min(vel, 0.) * right);
-    phiup(c2, 0) += dt * (std::max(vel, 0.) * left + std::min(vel, 0.) * right);
+    for (size_t it = 0; it < phi.size(); ++it) {
+        double left = (*phi[it])(c1, 0);
+        double right = (*phi[it])(c2, 0);
+
+        (*phiup[it])(c1, 0) -= dt * (std::max(vel, 0.) * left + std::min(vel, 0.) * right);
+        (*phiup[it])(c2, 0) += dt * (std::max(vel, 0.) * left + std::min(vel, 0.) * right);
+    }
 }
 
 template <int DG>
-inline void DGTransport<DG>::edge_term_X(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup, const DGVector<DG>& phi, // DG1 (3)
+inline void DGTransport<DG>::edge_term_X(const ParametricMesh& smesh, const double dt, const std::vector<DGVector<DG>*>& phiup, const std::vector<DGVector<DG>*>& phi, // DG1 (3)
     const EdgeVector<EDGEDOFS(DG)>& normalvel_X, const size_t c1, const size_t c2, const size_t ie)
 {
   if (smesh.landmask[c1]==0) return;
@@ -335,17 +404,19 @@ inline void DGTransport<DG>::edge_term_X(const ParametricMesh& smesh, const doub
   
   const LocalEdgeVector<GAUSSPOINTS1D(DG)> vel_gauss = normalvel_X.row(ie) * PSIe<EDGEDOFS(DG), GAUSSPOINTS1D(DG)>;
 
-  const LocalEdgeVector<GAUSSPOINTS1D(DG)> tmp =
-    (vel_gauss.array().max(0) * (topedgeofcell<DG>   (phi, c1) * PSIe<EDGEDOFS(DG), GAUSSPOINTS1D(DG)>).array() + 
-     vel_gauss.array().min(0) * (bottomedgeofcell<DG>(phi, c2) * PSIe<EDGEDOFS(DG), GAUSSPOINTS1D(DG)>).array() );
+  for (size_t it = 0; it < phi.size(); ++it) {
+    const LocalEdgeVector<GAUSSPOINTS1D(DG)> tmp =
+      (vel_gauss.array().max(0) * (topedgeofcell<DG>   (*phi[it], c1) * PSIe<EDGEDOFS(DG), GAUSSPOINTS1D(DG)>).array() + 
+       vel_gauss.array().min(0) * (bottomedgeofcell<DG>(*phi[it], c2) * PSIe<EDGEDOFS(DG), GAUSSPOINTS1D(DG)>).array() );
     
-    phiup.row(c1) -= dt * tmp * PSIe_w<DG, GAUSSPOINTS1D(DG), 2>;
-    phiup.row(c2) += dt * tmp * PSIe_w<DG, GAUSSPOINTS1D(DG), 0>;
+    phiup[it]->row(c1) -= dt * tmp * PSIe_w<DG, GAUSSPOINTS1D(DG), 2>;
+    phiup[it]->row(c2) += dt * tmp * PSIe_w<DG, GAUSSPOINTS1D(DG), 0>;
+  }
 }
 
 
 template <int DG>
-inline void DGTransport<DG>::edge_term_Y(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup, const DGVector<DG>& phi, // DG1 (3)
+inline void DGTransport<DG>::edge_term_Y(const ParametricMesh& smesh, const double dt, const std::vector<DGVector<DG>*>& phiup, const std::vector<DGVector<DG>*>& phi, // DG1 (3)
     const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c1, const size_t c2, const size_t ie)
 {
   if (smesh.landmask[c1]==0) return;
@@ -353,13 +424,15 @@ inline void DGTransport<DG>::edge_term_Y(const ParametricMesh& smesh, const doub
   
     const LocalEdgeVector<GAUSSPOINTS1D(DG)> vel_gauss = normalvel_Y.row(ie) * PSIe<EDGEDOFS(DG), GAUSSPOINTS1D(DG)>;
 
-    const LocalEdgeVector<EDGEDOFS(DG)> tmp =
-      (vel_gauss.array().max(0) * (rightedgeofcell<DG>(phi, c1) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() +
-       vel_gauss.array().min(0) * (leftedgeofcell <DG>(phi, c2) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array());
+    for (size_t it = 0; it < phi.size(); ++it) {
+      const LocalEdgeVector<EDGEDOFS(DG)> tmp =
+	(vel_gauss.array().max(0) * (rightedgeofcell<DG>(*phi[it], c1) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array() +
+	 vel_gauss.array().min(0) * (leftedgeofcell <DG>(*phi[it], c2) * PSIe<EDGEDOFS(DG), EDGEDOFS(DG)>).array());
 
-    // - [[psi]] sind we're on the left side
-    phiup.row(c1) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 1>;
-    phiup.row(c2) += dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 3>;
+      // - [[psi]] sind we're on the left side
+      phiup[it]->row(c1) -= dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 1>;
+      phiup[it]->row(c2) += dt * tmp * PSIe_w<DG, EDGEDOFS(DG), 3>;
+    }
 }
 
 template <int DG>
@@ -368,9 +441,10 @@ void DGTransport<DG>::DGTransportOperator(const ParametricMesh& smesh, const dou
     const DGVector<DG>& vy,
     const EdgeVector<EDGEDOFS(DG)>& normalvel_X,
     const EdgeVector<EDGEDOFS(DG)>& normalvel_Y,
-    const DGVector<DG>& phi, DGVector<DG>& phiup)
+    const std::vector<DGVector<DG>*>& phi, const std::vector<DGVector<DG>*>& phiup)
 {
-    phiup.zero();
+    for (DGVector<DG>* up : phiup)
+      up->zero();
 
     // Cell terms
 #pragma omp parallel for
@@ -425,13 +499,13 @@ void DGTransport<DG>::DGTransportOperator(const ParametricMesh& smesh, const dou
 	    const size_t iy = eid / smesh.nx;
     
 	    if (seg==0) // bottom
-	      boundary_lower(smesh, dt, phiup, phi, normalvel_X, eid, smesh.nx*iy+ix);
+	      boundary_lower(dt, phiup, phi, normalvel_X, eid, smesh.nx*iy+ix);
 	    else if (seg==1) // right
-	      boundary_right(smesh, dt, phiup, phi, normalvel_Y, eid, (smesh.nx+1)*iy+ix+1);
+	      boundary_right(dt, phiup, phi, normalvel_Y, eid, (smesh.nx+1)*iy+ix+1);
 	    else if (seg==2) // top
-	      boundary_upper(smesh, dt, phiup, phi, normalvel_X, eid, smesh.nx*(iy+1)+ix);
+	      boundary_upper(dt, phiup, phi, normalvel_X, eid, smesh.nx*(iy+1)+ix);
 	    else if (seg==3) // left
-	      boundary_left (smesh, dt, phiup, phi, normalvel_Y, eid, (smesh.nx+1)*iy+ix);
+	      boundary_left (dt, phiup, phi, normalvel_Y, eid, (smesh.nx+1)*iy+ix);
 	    else
 	      {
 		std::cerr << "Wrong Dirichlet boundary information in the mesh. Boundary side " << smesh.dirichlet[seg][i] << " not valid" << std::endl;
@@ -440,65 +514,130 @@ void DGTransport<DG>::DGTransportOperator(const ParametricMesh& smesh, const dou
 	  }
       }
    
+    if (parammap.matrixfree)
+      {
+#pragma omp parallel for
+	for (size_t eid = 0; eid < smesh.nelements; ++eid)
+	  {
+	    Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> mass
+	      = GAUSSWEIGHTS<GAUSSPOINTS1D(DG)>.cwiseProduct(ParametricTools::J<GAUSSPOINTS1D(DG)>(smesh, eid));
+	    if (smesh.CoordinateSystem == SPHERICAL)
+	      mass = mass.cwiseProduct((ParametricTools::getGaussPointsInElement<GAUSSPOINTS1D(DG)>(smesh, eid).row(1).array()).cos().matrix()) * Nextsim::EarthRadius;
+	    for (DGVector<DG>* up : phiup)
+	      up->row(eid) = SumFactorisation::applyInverseMass<DG, GAUSSPOINTS1D(DG)>(mass, up->row(eid).transpose()).transpose();
+	  }
+	return;
+      }
+
 #pragma omp parallel for
     for (size_t eid = 0; eid < smesh.nelements; ++eid)
-      phiup.row(eid) =  parammap.InverseDGMassMatrix[eid] * phiup.row(eid).transpose();
+      for (DGVector<DG>* up : phiup)
+	up->row(eid) =  parammap.InverseDGMassMatrix[eid] * up->row(eid).transpose();
 }
 
 template <int DG>
-void DGTransport<DG>::step_rk1(const double dt, DGVector<DG>& phi)
+void DGTransport<DG>::step_rk1(const double dt, const std::vector<DGVector<DG>*>& phi)
 {
-    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi, tmp1);
+    const std::vector<DGVector<DG>*> k1 = temporaries(tmp1, phi.size());
+
+    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi, k1);
 
-    phi += tmp1;
+    for (size_t it = 0; it < phi.size(); ++it)
+      *phi[it] += *k1[it];
 }
 
 template <int DG>
-void DGTransport<DG>::step_rk2(const double dt, DGVector<DG>& phi)
+void DGTransport<DG>::step_rk2(const double dt, const std::vector<DGVector<DG>*>& phi)
 {
-    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi, tmp1); // tmp1 = k * F(u)
+    const std::vector<DGVector<DG>*> k1 = temporaries(tmp1, phi.size());
+    const std::vector<DGVector<DG>*> k2 = temporaries(tmp2, phi.size());
 
-    phi += tmp1; // phi = phi + k * F(u)     (i.e.: implicit Euler)
+    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi, k1); // tmp1 = k * F(u)
 
-    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi, tmp2); // tmp1 = k * F( u + k * F(u) )
+    for (size_t it = 0; it < phi.size(); ++it)
+      *phi[it] += *k1[it]; // phi = phi + k * F(u)     (i.e.: implicit Euler)
 
-    phi += 0.5 * (tmp2 - tmp1);
+    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi, k2); // tmp1 = k * F( u + k * F(u) )
+
+    for (size_t it = 0; it < phi.size(); ++it)
+      *phi[it] += 0.5 * (*k2[it] - *k1[it]);
 }
 
 template <int DG>
-void DGTransport<DG>::step_rk3(const double dt, DGVector<DG>& phi)
+void DGTransport<DG>::step_rk3(const double dt, const std::vector<DGVector<DG>*>& phi)
 {
+    const std::vector<DGVector<DG>*> k1 = temporaries(tmp1, phi.size());
+    const std::vector<DGVector<DG>*> k2 = temporaries(tmp2, phi.size());
+    const std::vector<DGVector<DG>*> k3 = temporaries(tmp3, phi.size());
+
     DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, phi,
-        tmp1); // tmp1 = k * F(u)  // K1 in Heun(3)
-    tmp1 += phi; // phi + h f(phi)
+        k1); // tmp1 = k * F(u)  // K1 in Heun(3)
+    for (size_t it = 0; it < phi.size(); ++it)
+      *k1[it] += *phi[it]; // phi + h f(phi)
+
+    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, k1,
+        k2); // tmp2 = f( u + h f(u) )
+    for (size_t it = 0; it < phi.size(); ++it) {
+      *k2[it] += *k1[it];
+      *k2[it] *= 0.25;
+      *k2[it] += 0.75 * *phi[it];
+    }
 
-    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, tmp1,
-        tmp2); // tmp2 = f( u + h f(u) )
-    tmp2 += tmp1;
-    tmp2 *= 0.25;
-    tmp2 += 0.75 * phi;
+    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, k2,
+        k3); // k * F(k1) // K2 in Heun(3)
+    for (size_t it = 0; it < phi.size(); ++it) {
+      *k3[it] += *k2[it];
 
-    DGTransportOperator(smesh, dt, velx, vely, normalvel_X, normalvel_Y, tmp2,
-        tmp3); // k * F(k1) // K2 in Heun(3)
-    tmp3 += tmp2;
+      *phi[it] *= 1.0 / 3.0;
+      *phi[it] += 2.0 / 3.0 * *k3[it];
+    }
+}
 
-    phi *= 1.0 / 3.0;
-    phi += 2.0 / 3.0 * tmp3;
+template <int DG>
+std::vector<DGVector<DG>*> DGTransport<DG>::temporaries(std::vector<DGVector<DG>>& tmp, const size_t ntracers)
+{
+  // the vectors are kept, so that they are only allocated for the first step
+  while (tmp.size() < ntracers)
+    tmp.emplace_back(smesh);
+  std::vector<DGVector<DG>*> k(ntracers);
+  for (size_t it = 0; it < ntracers; ++it)
+    k[it] = &tmp[it];
+  return k;
 }
 
 template <int DG>
 void DGTransport<DG>::step(const double dt, DGVector<DG>& phi)
 {
-  if (timesteppingscheme == "rk1")
-    step_rk1(dt, phi);
-  else if (timesteppingscheme == "rk2")
-    step_rk2(dt, phi);
-  else if (timesteppingscheme == "rk3")
-    step_rk3(dt, phi);
-  else {
-    std::cerr << "Time stepping scheme '" << timesteppingscheme << "' not known!" << std::endl;
-    abort();
-  }
+  step(dt, std::vector<DGVector<DG>*>{ &phi });
+}
+
+template <int DG>
+void DGTransport<DG>::step(const double dt, const std::vector<DGVector<DG>*>& phi)
+{
+  lastcfl = dt * courantrate;
+  lastsubsteps = 1;
+  if (cflsafety > 0.)
+    {
+      // stability limit 1/(2p+1) for polynomial degree p
+      constexpr int degree = (DG == 1) ? 0 : ((DG == 3) ? 1 : 2);
+      const double maxcfl = cflsafety / (2 * degree + 1);
+      lastsubsteps = std::max<size_t>(1, static_cast<size_t>(std::ceil(lastcfl / maxcfl)));
+    }
+  const double subdt = dt / lastsubsteps;
+
+  for (size_t substep = 0; substep < lastsubsteps; ++substep)
+    {
+      if (timesteppingscheme == "rk1")
+	step_rk1(subdt, phi);
+      else if (timesteppingscheme == "rk2")
+	step_rk2(subdt, phi);
+      else if (timesteppingscheme == "rk3")
+	step_rk3(subdt, phi);
+      else {
+	std::cerr << "Time stepping scheme '" << timesteppingscheme << "' not known!" << std::endl;
+	abort();
+      }
+    }
 }
 
 #undef EDGEDOFS
@@ -72,30 +72,38 @@ namespace Interpolations {
         }
     }
 
+    //! The local unknowns of the CG vector in element dgi
+    template <int CG>
+    inline Eigen::Matrix<double, (CG == 2 ? 9 : 4), 1> CGLocal(
+        const ParametricMesh& smesh, const CGVector<CG>& cg, const size_t dgi)
+    {
+        const int cgshift = CG * smesh.nx + 1; //!< Index shift for each row
+        size_t iy = dgi / smesh.nx; //!< y-index of element
+        size_t ix = dgi % smesh.nx; //!< x-index of element
+
+        size_t cgi = CG * cgshift * iy + CG * ix; //!< lower/left Index in cg vector
+
+        Eigen::Matrix<double, (CG == 2 ? 9 : 4), 1> cg_local; //!< the 9 local unknowns in the element
+        if (CG == 1) {
+            cg_local << cg(cgi), cg(cgi + 1), cg(cgi + cgshift), cg(cgi + 1 + cgshift);
+        } else {
+            cg_local << cg(cgi), cg(cgi + 1), cg(cgi + 2), cg(cgi + cgshift), cg(cgi + 1 + cgshift),
+                cg(cgi + 2 + cgshift), cg(cgi + 2 * cgshift), cg(cgi + 1 + 2 * cgshift),
+                cg(cgi + 2 + 2 * cgshift);
+        }
+        return cg_local;
+    }
+
     template <int CG, int DG>
     void CG2DG(const ParametricMesh& smesh, DGVector<DG>& dg, const CGVector<CG>& cg)
     {
       assert(static_cast<long int>((CG * smesh.nx + 1) * (CG * smesh.ny + 1)) == cg.rows());
       assert(static_cast<long int>(smesh.nx * smesh.ny) == dg.rows());
 
-      const int cgshift = CG * smesh.nx + 1; //!< Index shift for each row
-
       // parallelize over elements
 #pragma omp parallel for
       for (size_t dgi = 0; dgi < smesh.nelements; ++dgi) {
-	size_t iy = dgi / smesh.nx; //!< y-index of element
-	size_t ix = dgi % smesh.nx; //!< x-index of element
-	  
-	size_t cgi = CG * cgshift * iy + CG * ix; //!< lower/left Index in cg vector
-
-	Eigen::Matrix<double, (CG == 2 ? 9 : 4), 1> cg_local; //!< the 9 local unknowns in the element
-	if (CG == 1) {
-	  cg_local << cg(cgi), cg(cgi + 1), cg(cgi + cgshift), cg(cgi + 1 + cgshift);
-	} else {
-	  cg_local << cg(cgi), cg(cgi + 1), cg(cgi + 2), cg(cgi + cgshift), cg(cgi + 1 + cgshift),
-	    cg(cgi + 2 + cgshift), cg(cgi + 2 * cgshift), cg(cgi + 1 + 2 * cgshift),
-	    cg(cgi + 2 + 2 * cgshift);
-	}
+	const Eigen::Matrix<double, (CG == 2 ? 9 : 4), 1> cg_local = CGLocal(smesh, cg, dgi);
 	// solve:  (Vdg, PHI) = (Vcg, PHI) with mapping to spher. coord.
 	if (smesh.CoordinateSystem == SPHERICAL)
 	  dg.row(dgi) =
@@ -114,6 +122,23 @@ namespace Interpolations {
 		
       }
     }
+
+    template <int CG, int DG>
+    void CG2DG(const ParametricMesh& smesh, DGVector<DG>& dg, const CGVector<CG>& cg,
+        const ParametricTransportMap<DG>& map)
+    {
+      if (map.matrixfree) {
+	CG2DG(smesh, dg, cg);
+	return;
+      }
+      assert(static_cast<long int>((CG * smesh.nx + 1) * (CG * smesh.ny + 1)) == cg.rows());
+      assert(static_cast<long int>(smesh.nx * smesh.ny) == dg.rows());
+
+      // solve:  (Vdg, PHI) = (Vcg, PHI) with the precomputed projection
+#pragma omp parallel for
+      for (size_t dgi = 0; dgi < smesh.nelements; ++dgi)
+	dg.row(dgi) = map.L2Projection[dgi] * (PHI<CG, GAUSSPOINTS1D(DG)>.transpose() * CGLocal(smesh, cg, dgi));
+    }
     
 
 
@@ -314,6 +339,13 @@ namespace Interpolations {
     template void CG2DG(const ParametricMesh& smesh, DGVector<3>& dg, const CGVector<2>& cg);
     template void CG2DG(const ParametricMesh& smesh, DGVector<6>& dg, const CGVector<2>& cg);
 
+    template void CG2DG(const ParametricMesh& smesh, DGVector<1>& dg, const CGVector<1>& cg, const ParametricTransportMap<1>& map);
+    template void CG2DG(const ParametricMesh& smesh, DGVector<3>& dg, const CGVector<1>& cg, const ParametricTransportMap<3>& map);
+    template void CG2DG(const ParametricMesh& smesh, DGVector<6>& dg, const CGVector<1>& cg, const ParametricTransportMap<6>& map);
+    template void CG2DG(const ParametricMesh& smesh, DGVector<1>& dg, const CGVector<2>& cg, const ParametricTransportMap<1>& map);
+    template void CG2DG(const ParametricMesh& smesh, DGVector<3>& dg, const CGVector<2>& cg, const ParametricTransportMap<3>& map);
+    template void CG2DG(const ParametricMesh& smesh, DGVector<6>& dg, const CGVector<2>& cg, const ParametricTransportMap<6>& map);
+
     template void Function2CG(
         const ParametricMesh& smesh, CGVector<1>& phi, const Function& initial);
     template void Function2CG(
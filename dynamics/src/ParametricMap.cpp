@@ -2,18 +2,60 @@
 #include "ParametricTools.hpp"
 #include "VectorManipulations.hpp"
 
+#include <array>
+#include <cmath>
+#include <map>
+
 
 namespace Nextsim
 {
+  ElementClasses::ElementClasses(const ParametricMesh& smesh)
+  {
+    classOf.resize(smesh.nelements);
+    if (smesh.nelements == 0)
+      return;
+
+    // Coordinates are compared up to a small fraction of the mesh size. The
+    // keys are the positions of the vertices relative to the first one and,
+    // in spherical coordinates, the latitude of the first vertex.
+    const double tol = 1.e-10 * smesh.hmin();
+    std::map<std::array<long long, 7>, size_t> classIndex;
+    for (size_t eid = 0; eid < smesh.nelements; ++eid)
+      {
+	const Eigen::Matrix<Nextsim::FloatType, 4, 2> coordinates = smesh.coordinatesOfElement(eid);
+	std::array<long long, 7> key;
+	for (size_t j = 1; j < 4; ++j)
+	  {
+	    key[2 * j - 2] = std::llround((coordinates(j, 0) - coordinates(0, 0)) / tol);
+	    key[2 * j - 1] = std::llround((coordinates(j, 1) - coordinates(0, 1)) / tol);
+	  }
+	key[6] = (smesh.CoordinateSystem == SPHERICAL) ? std::llround(coordinates(0, 1) / tol) : 0;
+
+	const auto inserted = classIndex.insert({ key, representatives.size() });
+	if (inserted.second)
+	  representatives.push_back(eid);
+	classOf[eid] = inserted.first->second;
+      }
+  }
+
+  //////////////////////////////////////////////////
+  // Transport
+  //////////////////////////////////////////////////
+
   template<int DG>
   void ParametricTransportMap<DG>::InitializeAdvectionCellTerms()
     {
     // for advection
     AdvectionCellTermX.clear();
     AdvectionCellTermY.clear();
+    if (matrixfree)
+      return;
+
+    if (!classes)
+      classes = std::make_shared<const ElementClasses>(smesh);
 
-    AdvectionCellTermX.resize(smesh.nelements);
-    AdvectionCellTermY.resize(smesh.nelements);
+    AdvectionCellTermX.resize(classes);
+    AdvectionCellTermY.resize(classes);
 
 
     // gradient of transformation
@@ -30,24 +72,26 @@ namespace Nextsim
     // Store wq * phi(q)
 
 
+    // the matrices are computed once for each class of equivalent elements
 #pragma omp parallel for
-    for (size_t eid = 0; eid<smesh.nelements;++eid)
+    for (size_t ic = 0; ic<classes->size();++ic)
       {
+	const size_t eid = classes->representatives[ic];
 	const Eigen::Matrix<Nextsim::FloatType, 2, GAUSSPOINTS(DG)> dxT = ParametricTools::dxT<GAUSSPOINTS1D(DG)>(smesh, eid).array().rowwise() * GAUSSWEIGHTS<GAUSSPOINTS1D(DG)>.array();
 	const Eigen::Matrix<Nextsim::FloatType, 2, GAUSSPOINTS(DG)> dyT = ParametricTools::dyT<GAUSSPOINTS1D(DG)>(smesh, eid).array().rowwise() * GAUSSWEIGHTS<GAUSSPOINTS1D(DG)>.array();
 
 	// [J dT^{-T} nabla phi]_1
-	AdvectionCellTermX[eid] = PSIx<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dyT.row(1).array() - PSIy<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dxT.row(1).array();
+	AdvectionCellTermX.matrices[ic] = PSIx<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dyT.row(1).array() - PSIy<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dxT.row(1).array();
 	// [J dT^{-T} nabla phi]_2
 
 	//! the lat-direction must be scaled with the metric term if in the spherical system
 	if (smesh.CoordinateSystem == SPHERICAL)
 	  {
 	    const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> cos_lat = (ParametricTools::getGaussPointsInElement<GAUSSPOINTS1D(DG)>(smesh, eid).row(1).array()).cos();
-	    AdvectionCellTermY[eid] = PSIy<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * (dxT.row(0).array() * cos_lat.array()) - PSIx<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * (dyT.row(0).array() * cos_lat.array());
+	    AdvectionCellTermY.matrices[ic] = PSIy<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * (dxT.row(0).array() * cos_lat.array()) - PSIx<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * (dyT.row(0).array() * cos_lat.array());
 	  }
 	else if (smesh.CoordinateSystem == CARTESIAN)
-	  AdvectionCellTermY[eid] = PSIy<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dxT.row(0).array() - PSIx<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dyT.row(0).array();
+	  AdvectionCellTermY.matrices[ic] = PSIy<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dxT.row(0).array() - PSIx<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * dyT.row(0).array();
 	else abort();
       }
   }
@@ -59,20 +103,25 @@ namespace Nextsim
     {
     // for advection
       InverseDGMassMatrix.clear();
-      InverseDGMassMatrix.resize(smesh.nelements);
+      if (matrixfree)
+	return;
+
+      if (!classes)
+	classes = std::make_shared<const ElementClasses>(smesh);
+      InverseDGMassMatrix.resize(classes);
 
 
       if (smesh.CoordinateSystem == SPHERICAL)
 	{
 #pragma omp parallel for
-	  for (size_t eid = 0; eid<smesh.nelements;++eid)
-	    InverseDGMassMatrix[eid] = SphericalTools::massMatrix<DG>(smesh, eid).inverse() / Nextsim::EarthRadius;
+	  for (size_t ic = 0; ic<classes->size();++ic)
+	    InverseDGMassMatrix.matrices[ic] = SphericalTools::massMatrix<DG>(smesh, classes->representatives[ic]).inverse() / Nextsim::EarthRadius;
 	}
       else if (smesh.CoordinateSystem == CARTESIAN)
 	{
 #pragma omp parallel for
-	  for (size_t eid = 0; eid<smesh.nelements;++eid)
-	    InverseDGMassMatrix[eid] = ParametricTools::massMatrix<DG>(smesh, eid).inverse();
+	  for (size_t ic = 0; ic<classes->size();++ic)
+	    InverseDGMassMatrix.matrices[ic] = ParametricTools::massMatrix<DG>(smesh, classes->representatives[ic]).inverse();
 	}
       else
 	{
@@ -81,6 +130,35 @@ namespace Nextsim
 	}
   }
 
+  template<int DG>
+  void ParametricTransportMap<DG>::InitializeL2Projection()
+    {
+      L2Projection.clear();
+      if (matrixfree)
+	return;
+
+      if (!classes)
+	classes = std::make_shared<const ElementClasses>(smesh);
+      L2Projection.resize(classes);
+
+#pragma omp parallel for
+      for (size_t ic = 0; ic<classes->size();++ic)
+	{
+	  const size_t eid = classes->representatives[ic];
+	  const Eigen::Matrix<Nextsim::FloatType, 1, GAUSSPOINTS(DG)> Jw
+	    = ParametricTools::J<GAUSSPOINTS1D(DG)>(smesh, eid).array() * GAUSSWEIGHTS<GAUSSPOINTS1D(DG)>.array();
+	  if (smesh.CoordinateSystem == SPHERICAL)
+	    L2Projection.matrices[ic] = SphericalTools::massMatrix<DG>(smesh, eid).inverse()
+	      * (PSI<DG, GAUSSPOINTS1D(DG)>.array().rowwise()
+		 * (Jw.array() * (ParametricTools::getGaussPointsInElement<GAUSSPOINTS1D(DG)>(smesh, eid).row(1).array()).cos())).matrix();
+	  else if (smesh.CoordinateSystem == CARTESIAN)
+	    L2Projection.matrices[ic] = ParametricTools::massMatrix<DG>(smesh, eid).inverse()
+	      * (PSI<DG, GAUSSPOINTS1D(DG)>.array().rowwise() * Jw.array()).matrix();
+	  else
+	    abort();
+	}
+  }
+
 
   //////////////////////////////////////////////////
   // Momentum
@@ -170,20 +248,27 @@ namespace Nextsim
   template<int CG>
   void ParametricMomentumMap<CG>::InitializeDivSMatrices()
   {
-    divS1.resize(smesh.nelements);
-    divS2.resize(smesh.nelements);
-    iMgradX.resize(smesh.nelements);
-    iMgradY.resize(smesh.nelements);
-    iMJwPSI.resize(smesh.nelements);
+    if (matrixfree)
+      return;
+
+    if (!classes)
+      classes = std::make_shared<const ElementClasses>(smesh);
+
+    divS1.resize(classes);
+    divS2.resize(classes);
+    iMgradX.resize(classes);
+    iMgradY.resize(classes);
+    iMJwPSI.resize(classes);
     if (smesh.CoordinateSystem == SPHERICAL)
       {
-	divM.resize(smesh.nelements);
-	iMM.resize(smesh.nelements);
+	divM.resize(classes);
+	iMM.resize(classes);
       }
 
-    // parallel loop over all elements for computing entries
+    // parallel loop over one element of each class for computing entries
 #pragma omp parallel for
-    for (size_t eid = 0; eid < smesh.nelements; ++eid) {
+    for (size_t ic = 0; ic < classes->size(); ++ic) {
+      const size_t eid = classes->representatives[ic];
 
       //     [ Fx   Fx ]
       // F = [         ]
@@ -210,16 +295,16 @@ namespace Nextsim
       if (smesh.CoordinateSystem == CARTESIAN)
 	{
 	  // divS is used for update of stress (S, nabla Phi) in Momentum
-	  divS1[eid] = dx_cg2 * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose();
-	  divS2[eid] = dy_cg2 * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose();
+	  divS1.matrices[ic] = dx_cg2 * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose();
+	  divS2.matrices[ic] = dy_cg2 * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose();
 
 	  // iMgradX/Y (inverse-Mass-gradient X/Y) is used to project strain rate from CG to DG
 	  const Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), CG2DGSTRESS(CG)> imass = ParametricTools::massMatrix<CG2DGSTRESS(CG)>(smesh, eid).inverse();
-	  iMgradX[eid] = imass * divS1[eid].transpose();
-	  iMgradY[eid] = imass * divS2[eid].transpose();
+	  iMgradX.matrices[ic] = imass * divS1.matrices[ic].transpose();
+	  iMgradY.matrices[ic] = imass * divS2.matrices[ic].transpose();
 
 	  // imJwPSI is used to compute nonlinear stress update???
-	  iMJwPSI[eid] = imass * (PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array().rowwise() * (GAUSSWEIGHTS<GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array() * J.array())).matrix();
+	  iMJwPSI.matrices[ic] = imass * (PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array().rowwise() * (GAUSSWEIGHTS<GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array() * J.array())).matrix();
 	}
       else if (smesh.CoordinateSystem == SPHERICAL)
 	{
@@ -231,22 +316,22 @@ namespace Nextsim
 	    sin_lat = (ParametricTools::getGaussPointsInElement<GAUSSPOINTS1D(CG2DGSTRESS(CG))>(smesh, eid).row(1).array()).sin();
 
 	  // 1 is lon-derivative, 2 is lat-derivative of the test function
-	  divS1[eid] =  dx_cg2                                               * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose() / Nextsim::EarthRadius;
-	  divS2[eid] = (dy_cg2.array().rowwise() * cos_lat.array()).matrix() * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose() / Nextsim::EarthRadius;
+	  divS1.matrices[ic] =  dx_cg2                                               * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose() / Nextsim::EarthRadius;
+	  divS2.matrices[ic] = (dy_cg2.array().rowwise() * cos_lat.array()).matrix() * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose() / Nextsim::EarthRadius;
 
 
-	  divM [eid] = (PHI<CG, GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array().rowwise()
+	  divM.matrices[ic] = (PHI<CG, GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array().rowwise()
 			* (J.array()
 			   * sin_lat.array()
 			   * GAUSSWEIGHTS<GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array())
 			).matrix() * PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.transpose() / Nextsim::EarthRadius;
 
 	  const Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), CG2DGSTRESS(CG)> imass = SphericalTools::massMatrix<CG2DGSTRESS(CG)>(smesh, eid).inverse();
-	  iMgradX[eid] = imass * divS1[eid].transpose();
-	  iMgradY[eid] = imass * divS2[eid].transpose();
-	  iMM[eid]     = imass * divM [eid].transpose();
+	  iMgradX.matrices[ic] = imass * divS1.matrices[ic].transpose();
+	  iMgradY.matrices[ic] = imass * divS2.matrices[ic].transpose();
+	  iMM.matrices[ic]     = imass * divM.matrices[ic].transpose();
 
-	  iMJwPSI[eid] = imass * (PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array().rowwise() * (GAUSSWEIGHTS<GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array() * J.array())).matrix();
+	  iMJwPSI.matrices[ic] = imass * (PSI<CG2DGSTRESS(CG), GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array().rowwise() * (GAUSSWEIGHTS<GAUSSPOINTS1D(CG2DGSTRESS(CG))>.array() * J.array())).matrix();
 
 	}
       else abort();
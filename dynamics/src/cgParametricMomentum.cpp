@@ -9,10 +9,13 @@
 #include "MEB.hpp"
 #include "BBM.hpp"
 #include "ParametricTools.hpp"
+#include "SumFactorisation.hpp"
 #include "mevp.hpp"
 #include "dgVisu.hpp"
 #include "VectorManipulations.hpp"
 
+#include <algorithm>
+
 namespace Nextsim {
 
 #define DGSTRESS(CG) ( (CG==1?3:(CG==2?8:-1) ) )
@@ -42,40 +45,140 @@ namespace Nextsim {
 
 	if (smesh.landmask[dgi]==0) // only on ice
 	  continue;
-	      
-	      
-	// get the 4 (cg1) 9 (cg2) local x/y - velocity coefficients on the element
-	Eigen::Matrix<double, CGDOFS(CG), 1> vx_local, vy_local;
-	if (CG == 1) {
-	  vx_local << vx(cgi), vx(cgi + 1), vx(cgi + cgshift), vx(cgi + 1 + cgshift);
-	  vy_local << vy(cgi), vy(cgi + 1), vy(cgi + cgshift), vy(cgi + 1 + cgshift);
-	} else if (CG == 2) {
-	  vx_local << vx(cgi), vx(cgi + 1), vx(cgi + 2), vx(cgi + cgshift), vx(cgi + 1 + cgshift),
-	    vx(cgi + 2 + cgshift), vx(cgi + 2 * cgshift), vx(cgi + 1 + 2 * cgshift),
-	    vx(cgi + 2 + 2 * cgshift);
-
-	  vy_local << vy(cgi), vy(cgi + 1), vy(cgi + 2), vy(cgi + cgshift), vy(cgi + 1 + cgshift),
-	    vy(cgi + 2 + cgshift), vy(cgi + 2 * cgshift), vy(cgi + 1 + 2 * cgshift),
-	    vy(cgi + 2 + 2 * cgshift);
-	} else
-	  abort();
-
-	// Solve (E, Psi) = (0.5(DV + DV^T), Psi)
-	// by integrating rhs and inverting with dG(stress) mass matrix
-	//
-	E11.row(dgi) = pmap.iMgradX[dgi] * vx_local;
-	E22.row(dgi) = pmap.iMgradY[dgi] * vy_local;
-	E12.row(dgi) = 0.5 * (pmap.iMgradX[dgi] * vy_local + pmap.iMgradY[dgi] * vx_local);
-
-	if (smesh.CoordinateSystem == SPHERICAL)
-	  {
-	    E11.row(dgi) -= pmap.iMM[dgi] * vy_local;
-	    E12.row(dgi) += 0.5 * pmap.iMM[dgi] * vx_local;
-	  }
+
+	ProjectCGVelocityToDGStrainCell(dgi, cgi);
       }
     }
   }
 
+  template <int CG>
+  void CGParametricMomentum<CG>::ProjectCGVelocityToDGStrainCell(const size_t dgi, const size_t cgi)
+  {
+    const int cgshift = CG * smesh.nx + 1; //!< Index shift for each row
+
+    // get the 4 (cg1) 9 (cg2) local x/y - velocity coefficients on the element
+    Eigen::Matrix<double, CGDOFS(CG), 1> vx_local, vy_local;
+    if (CG == 1) {
+      vx_local << vx(cgi), vx(cgi + 1), vx(cgi + cgshift), vx(cgi + 1 + cgshift);
+      vy_local << vy(cgi), vy(cgi + 1), vy(cgi + cgshift), vy(cgi + 1 + cgshift);
+    } else if (CG == 2) {
+      vx_local << vx(cgi), vx(cgi + 1), vx(cgi + 2), vx(cgi + cgshift), vx(cgi + 1 + cgshift),
+        vx(cgi + 2 + cgshift), vx(cgi + 2 * cgshift), vx(cgi + 1 + 2 * cgshift),
+        vx(cgi + 2 + 2 * cgshift);
+
+      vy_local << vy(cgi), vy(cgi + 1), vy(cgi + 2), vy(cgi + cgshift), vy(cgi + 1 + cgshift),
+        vy(cgi + 2 + cgshift), vy(cgi + 2 * cgshift), vy(cgi + 1 + 2 * cgshift),
+        vy(cgi + 2 + 2 * cgshift);
+    } else
+      abort();
+
+    if (pmap.matrixfree)
+      {
+	MatrixFreeStrainCell(dgi, vx_local, vy_local);
+	return;
+      }
+
+    // Solve (E, Psi) = (0.5(DV + DV^T), Psi)
+    // by integrating rhs and inverting with dG(stress) mass matrix
+    //
+    E11.row(dgi) = pmap.iMgradX[dgi] * vx_local;
+    E22.row(dgi) = pmap.iMgradY[dgi] * vy_local;
+    E12.row(dgi) = 0.5 * (pmap.iMgradX[dgi] * vy_local + pmap.iMgradY[dgi] * vx_local);
+
+    if (smesh.CoordinateSystem == SPHERICAL)
+      {
+        E11.row(dgi) -= pmap.iMM[dgi] * vy_local;
+        E12.row(dgi) += 0.5 * pmap.iMM[dgi] * vx_local;
+      }
+  }
+
+  template <int CG>
+  void CGParametricMomentum<CG>::MatrixFreeStrainCell(const size_t dgi,
+						       const Eigen::Matrix<double, CGDOFS(CG), 1>& vx_local,
+						       const Eigen::Matrix<double, CGDOFS(CG), 1>& vy_local)
+  {
+    constexpr int NGP = GAUSSPOINTS1D(CG2DGSTRESS(CG));
+    typedef Eigen::Matrix<double, 1, NGP * NGP> GaussVector;
+    const SumFactorisation::ElementGeometry<NGP> geo(smesh, dgi);
+
+    // reference gradients of the velocity in the Gauss points
+    GaussVector vx_x, vx_y, vy_x, vy_y;
+    SumFactorisation::evaluateCGGradient<CG, NGP>(vx_local, vx_x, vx_y);
+    SumFactorisation::evaluateCGGradient<CG, NGP>(vy_local, vy_x, vy_y);
+
+    // J dT^{-T} nabla v, times the Gauss weights
+    GaussVector dx_vx = vx_x.cwiseProduct(geo.Fy.row(1)) - vx_y.cwiseProduct(geo.Fx.row(1));
+    GaussVector dx_vy = vy_x.cwiseProduct(geo.Fy.row(1)) - vy_y.cwiseProduct(geo.Fx.row(1));
+    GaussVector dy_vx = vx_y.cwiseProduct(geo.Fx.row(0)) - vx_x.cwiseProduct(geo.Fy.row(0));
+    GaussVector dy_vy = vy_y.cwiseProduct(geo.Fx.row(0)) - vy_x.cwiseProduct(geo.Fy.row(0));
+    GaussVector mass = GAUSSWEIGHTS<NGP>.cwiseProduct(geo.J);
+
+    if (smesh.CoordinateSystem == SPHERICAL)
+      {
+	// lat-derivatives carry the metric term, and the derivative of the
+	// units adds the terms with sin(lat)
+	dy_vx = dy_vx.cwiseProduct(geo.cos_lat);
+	dy_vy = dy_vy.cwiseProduct(geo.cos_lat);
+	const GaussVector m = mass.cwiseProduct(geo.sin_lat);
+	dx_vx -= m.cwiseProduct(SumFactorisation::evaluateCG<CG, NGP>(vy_local));
+	dx_vy += m.cwiseProduct(SumFactorisation::evaluateCG<CG, NGP>(vx_local));
+	dx_vx /= Nextsim::EarthRadius;
+	dx_vy /= Nextsim::EarthRadius;
+	dy_vx /= Nextsim::EarthRadius;
+	dy_vy /= Nextsim::EarthRadius;
+	mass = mass.cwiseProduct(geo.cos_lat);
+      }
+
+    E11.row(dgi) = SumFactorisation::applyInverseMass<CG2DGSTRESS(CG), NGP>(mass,
+	SumFactorisation::integrateDG<CG2DGSTRESS(CG), NGP>(dx_vx));
+    E22.row(dgi) = SumFactorisation::applyInverseMass<CG2DGSTRESS(CG), NGP>(mass,
+	SumFactorisation::integrateDG<CG2DGSTRESS(CG), NGP>(dy_vy));
+    E12.row(dgi) = 0.5 * SumFactorisation::applyInverseMass<CG2DGSTRESS(CG), NGP>(mass,
+	SumFactorisation::integrateDG<CG2DGSTRESS(CG), NGP>(dx_vy + dy_vx));
+  }
+
+  template <int CG>
+  void CGParametricMomentum<CG>::MatrixFreeStressTensorCell(const double scale, const size_t eid,
+							     Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)>& tx,
+							     Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)>& ty) const
+  {
+    constexpr int NGP = GAUSSPOINTS1D(CG2DGSTRESS(CG));
+    typedef Eigen::Matrix<double, 1, NGP * NGP> GaussVector;
+    const SumFactorisation::ElementGeometry<NGP> geo(smesh, eid);
+
+    const GaussVector s11 = SumFactorisation::evaluateDG<CG2DGSTRESS(CG), NGP>(S11.row(eid));
+    const GaussVector s12 = SumFactorisation::evaluateDG<CG2DGSTRESS(CG), NGP>(S12.row(eid));
+    const GaussVector s22 = SumFactorisation::evaluateDG<CG2DGSTRESS(CG), NGP>(S22.row(eid));
+
+    // (S, J dT^{-T} nabla phi) written as integrals against the reference gradient
+    if (smesh.CoordinateSystem == CARTESIAN)
+      {
+	tx = scale * SumFactorisation::integrateCGGradient<CG, NGP>(
+	    geo.Fy.row(1).cwiseProduct(s11) - geo.Fy.row(0).cwiseProduct(s12),
+	    geo.Fx.row(0).cwiseProduct(s12) - geo.Fx.row(1).cwiseProduct(s11));
+	ty = scale * SumFactorisation::integrateCGGradient<CG, NGP>(
+	    geo.Fy.row(1).cwiseProduct(s12) - geo.Fy.row(0).cwiseProduct(s22),
+	    geo.Fx.row(0).cwiseProduct(s22) - geo.Fx.row(1).cwiseProduct(s12));
+      }
+    else if (smesh.CoordinateSystem == SPHERICAL)
+      {
+	// the lat-derivative carries the metric term and the derivative
+	// of the units adds the terms with sin(lat)
+	const GaussVector c12 = geo.cos_lat.cwiseProduct(s12);
+	const GaussVector c22 = geo.cos_lat.cwiseProduct(s22);
+	const GaussVector m = GAUSSWEIGHTS<NGP>.cwiseProduct(geo.J).cwiseProduct(geo.sin_lat);
+	const double s = scale / Nextsim::EarthRadius;
+	tx = s * SumFactorisation::integrateCGGradient<CG, NGP>(m.cwiseProduct(s12),
+	    geo.Fy.row(1).cwiseProduct(s11) - geo.Fy.row(0).cwiseProduct(c12),
+	    geo.Fx.row(0).cwiseProduct(c12) - geo.Fx.row(1).cwiseProduct(s11));
+	ty = s * SumFactorisation::integrateCGGradient<CG, NGP>(-m.cwiseProduct(s11),
+	    geo.Fy.row(1).cwiseProduct(s12) - geo.Fy.row(0).cwiseProduct(c22),
+	    geo.Fx.row(0).cwiseProduct(c22) - geo.Fx.row(1).cwiseProduct(s12));
+      }
+    else
+      abort();
+  }
+
   ////////////////////////////////////////////////// STRESS Tensor
   // Sasip-Mesh Interface
   template <int CG>
@@ -109,6 +212,50 @@ namespace Nextsim {
     VectorManipulations::CGAveragePeriodic(smesh, ty);
   }
 
+  template <int CG>
+  template <int DG>
+  void CGParametricMomentum<CG>::mEVPStressDivergence(const VPParameters& params,
+						      const double alpha, const double scale,
+						      const DGVector<DG>& H, const DGVector<DG>& A,
+						      CGVector<CG>& tx, CGVector<CG>& ty)
+  {
+#pragma omp parallel for
+    for (size_t i=0;i<tx.rows();++i)
+      {
+	tx(i)=0.0;
+	ty(i)=0.0;
+      }
+
+    // Strain, stress and divergence of each element are computed in one
+    // pass, while its data is in cache. The stripes of DivergenceOfStress
+    // keep the scatter into the shared CG nodes free of races.
+    const size_t cgshift = CG * smesh.nx + 1; //!< Index shift for each row
+    for (size_t p = 0; p < 2; ++p)
+#pragma omp parallel for schedule(static)
+      for (size_t cy = 0; cy < smesh.ny; ++cy) //!< loop over all cells of the mesh
+        {
+	  if (cy % 2 == p) {
+	    size_t c = smesh.nx * cy;
+	    size_t cgi = CG * cgshift * cy;
+	    for (size_t cx = 0; cx < smesh.nx; ++cx, ++c, cgi += CG) //!< loop over all cells of the mesh
+	      {
+		// the stress is also updated on land, as in StressUpdateHighOrder
+		if (smesh.landmask[c]==1) // only on ice!
+		  ProjectCGVelocityToDGStrainCell(c, cgi);
+		Nextsim::mEVP::StressUpdateElement(params, pmap, smesh, c, S11, S12, S22, E11, E12, E22, H, A, alpha);
+		if (smesh.landmask[c]==1) // only on ice!
+		  AddStressTensorCell(scale, c, cx, cy, tx, ty);
+	      }
+	  }
+        }
+    // set zero on the Dirichlet boundaries
+    DirichletZero(tx);
+    DirichletZero(ty);
+    // add the contributions on the periodic boundaries
+    VectorManipulations::CGAveragePeriodic(smesh, tx);
+    VectorManipulations::CGAveragePeriodic(smesh, ty);
+  }
+
   template <int CG>
   void CGParametricMomentum<CG>::DirichletZero(CGVector<CG>& v) const
   {
@@ -207,44 +354,54 @@ namespace Nextsim {
     cg_A = cg_A.cwiseMin(1.0);
     cg_A = cg_A.cwiseMax(1.e-4);
     cg_H = cg_H.cwiseMax(1.e-4);
+
+    // mark the nodes that mEVPStep resets to zero on the boundary and on land
+    free_nodes.setConstant(1.0);
+    DirichletZero(free_nodes);
+    const size_t inrow = CG*smesh.nx+1;
+    for (size_t eid=0;eid<smesh.nelements;++eid)
+      if (smesh.landmask[eid]==0)
+	{
+	  const size_t ex = eid%smesh.nx;
+	  const size_t ey = eid/smesh.nx;
+	  for (int jy=0;jy<CG+1;++jy)
+	    for (int jx=0;jx<CG+1;++jx)
+	      free_nodes(inrow*(CG*ey+jy)+CG*ex+jx)=0.0;
+	}
 }
 
   template <int CG>
   template <int DG>
-  void CGParametricMomentum<CG>::mEVPStep(const VPParameters& params,
+  double CGParametricMomentum<CG>::mEVPStep(const VPParameters& params,
 					  const size_t NT_evp, const double alpha, const double beta,
 					  double dt_adv,
-					  const DGVector<DG>& H, const DGVector<DG>& A)
+					  const DGVector<DG>& H, const DGVector<DG>& A,
+					  const bool measureChange)
   {
     
-    // Compute Strain Rate
-    
-    ProjectCGVelocityToDGStrain();
-    
-
-
-    // Update the stresses according to the mEVP model
-    
-    Nextsim::mEVP::StressUpdateHighOrder(params, pmap, smesh, S11, S12, S22, E11, E12, E22, H, A, alpha, beta);
-    
-
-    // Compute the divergence of the stress tensor
-    
+    // Compute the strain rate, update the stresses according to the mEVP
+    // model and compute the divergence of the stress tensor
 
     double stressscale = 1.0; // 2nd-order Stress term has different scaling with the EarthRadius
     if (smesh.CoordinateSystem == Nextsim::SPHERICAL)
       stressscale = 1.0/Nextsim::EarthRadius/Nextsim::EarthRadius;
 
-    DivergenceOfStress(stressscale, tmpx, tmpy); // Compute divergence of stress tensor
+    mEVPStressDivergence(params, alpha, stressscale, H, A, tmpx, tmpy);
     
     
 
     // Update the velocity
     double SC = 1.0;///(1.0-pow(1.0+1.0/beta,-1.0*NT_evp));
     
+    // max-norm of the change in velocity. The nodes reset below to zero on
+    // the boundary and on land are left out.
+    double change = 0.0;
+
     //	    update by a loop.. implicit parts and h-dependent
-#pragma omp parallel for
+#pragma omp parallel for reduction(max : change)
     for (int i = 0; i < vx.rows(); ++i) {
+      const double vx_prev = vx(i);
+      const double vy_prev = vy(i);
       double absatm = sqrt(ax(i)*ax(i)+ay(i)*ay(i));
       double absocn = sqrt(SQR(vx(i)-ox(i)) + SQR(vy(i)-oy(i)));
 
@@ -278,6 +435,9 @@ namespace Nextsim {
 		  * (ox(i) - vx(i))
 		  + tmpy(i)/pmap.lumpedcgmass(i)
 		  ));
+      if (measureChange)
+	change = std::max(change,
+	    free_nodes(i) * std::max(fabs(vx(i) - vx_prev), fabs(vy(i) - vy_prev)));
     }
        
        
@@ -298,7 +458,8 @@ namespace Nextsim {
 		vy(inrow*(CG*ey+jy)+CG*ex+jx)=0.0;
 	      }
 	}
-    
+
+    return change;
 }
   // --------------------------------------------------
   template <int CG>
@@ -585,31 +746,65 @@ void CGParametricMomentum<CG>::MEBStep(const MEBParameters& params,
 
   // --------------------------------------------------
 
-  template void CGParametricMomentum<1>::mEVPStep(const VPParameters& params,
+  template double CGParametricMomentum<1>::mEVPStep(const VPParameters& params,
 						  size_t NT_evp, double alpha, double beta,
 						  double dt_adv,
-						  const DGVector<1>& H, const DGVector<1>& A);
-  template void CGParametricMomentum<1>::mEVPStep(const VPParameters& params,
+						  const DGVector<1>& H, const DGVector<1>& A,
+						  bool measureChange);
+  template double CGParametricMomentum<1>::mEVPStep(const VPParameters& params,
 						  size_t NT_evp, double alpha, double beta,
 						  double dt_adv,
-						  const DGVector<3>& H, const DGVector<3>& A);
-  template void CGParametricMomentum<1>::mEVPStep(const VPParameters& params,
+						  const DGVector<3>& H, const DGVector<3>& A,
+						  bool measureChange);
+  template double CGParametricMomentum<1>::mEVPStep(const VPParameters& params,
 						  size_t NT_evp, double alpha, double beta,
 						  double dt_adv,
-						  const DGVector<6>& H, const DGVector<6>& A);
+						  const DGVector<6>& H, const DGVector<6>& A,
+						  bool measureChange);
 
-  template void CGParametricMomentum<2>::mEVPStep(const VPParameters& params,
+  template double CGParametricMomentum<2>::mEVPStep(const VPParameters& params,
 						  size_t NT_evp, double alpha, double beta,
 						  double dt_adv,
-						  const DGVector<1>& H, const DGVector<1>& A);
-  template void CGParametricMomentum<2>::mEVPStep(const VPParameters& params,
+						  const DGVector<1>& H, const DGVector<1>& A,
+						  bool measureChange);
+  template double CGParametricMomentum<2>::mEVPStep(const VPParameters& params,
 						  size_t NT_evp, double alpha, double beta,
 						  double dt_adv,
-						  const DGVector<3>& H, const DGVector<3>& A);
-  template void CGParametricMomentum<2>::mEVPStep(const VPParameters& params,
+						  const DGVector<3>& H, const DGVector<3>& A,
+						  bool measureChange);
+  template double CGParametricMomentum<2>::mEVPStep(const VPParameters& params,
 						  size_t NT_evp, double alpha, double beta,
 						  double dt_adv,
-						  const DGVector<6>& H, const DGVector<6>& A);
+						  const DGVector<6>& H, const DGVector<6>& A,
+						  bool measureChange);
+
+  // --------------------------------------------------
+
+  template void CGParametricMomentum<1>::mEVPStressDivergence(const VPParameters& params,
+						  const double alpha, const double scale,
+						  const DGVector<1>& H, const DGVector<1>& A,
+						  CGVector<1>& tx, CGVector<1>& ty);
+  template void CGParametricMomentum<1>::mEVPStressDivergence(const VPParameters& params,
+						  const double alpha, const double scale,
+						  const DGVector<3>& H, const DGVector<3>& A,
+						  CGVector<1>& tx, CGVector<1>& ty);
+  template void CGParametricMomentum<1>::mEVPStressDivergence(const VPParameters& params,
+						  const double alpha, const double scale,
+						  const DGVector<6>& H, const DGVector<6>& A,
+						  CGVector<1>& tx, CGVector<1>& ty);
+
+  template void CGParametricMomentum<2>::mEVPStressDivergence(const VPParameters& params,
+						  const double alpha, const double scale,
+						  const DGVector<1>& H, const DGVector<1>& A,
+						  CGVector<2>& tx, CGVector<2>& ty);
+  template void CGParametricMomentum<2>::mEVPStressDivergence(const VPParameters& params,
+						  const double alpha, const double scale,
+						  const DGVector<3>& H, const DGVector<3>& A,
+						  CGVector<2>& tx, CGVector<2>& ty);
+  template void CGParametricMomentum<2>::mEVPStressDivergence(const VPParameters& params,
+						  const double alpha, const double scale,
+						  const DGVector<6>& H, const DGVector<6>& A,
+						  CGVector<2>& tx, CGVector<2>& ty);
 
   // --------------------------------------------------
 
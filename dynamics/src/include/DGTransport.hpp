@@ -11,6 +11,8 @@
 #include "dgVector.hpp"
 #include "ParametricMap.hpp"
 
+#include <vector>
+
 
 namespace Nextsim {
 
@@ -45,37 +47,53 @@ protected:
     //! normal velocity in edges parallel to X- and Y-axis
     EdgeVector<EDGEDOFS(DG)> normalvel_X, normalvel_Y;
 
-    //! temporary vectors for time stepping
-    DGVector<DG> tmp1, tmp2, tmp3;
+    //! temporary vectors for time stepping, one for each tracer
+    std::vector<DGVector<DG>> tmp1, tmp2, tmp3;
+
+    //! Largest normal flux over an edge divided by the size of the element. Times dt this is the Courant number
+    double courantrate = 0.;
+    //! Safety factor for the automatic sub-stepping. Zero disables the sub-stepping
+    double cflsafety = 0.;
+    //! Courant number and number of sub-steps of the last time step
+    double lastcfl = 0.;
+    size_t lastsubsteps = 1;
 
     //! Internal functions
 
     /*!
      * Performs one time step transporting phi with the Fwd-Euler Scheme
      *
-     * @params phi is the vector of values to be transported
+     * @params phi are the vectors of values to be transported
      */
-    void step_rk1(const double dt, DGVector<DG>& phi);
+    void step_rk1(const double dt, const std::vector<DGVector<DG>*>& phi);
 
     /*!
      * Performs one time step transporting phi with the 2nd Order Heun Scheme
      *
-     * @params phi is the vector of values to be transported
+     * @params phi are the vectors of values to be transported
      */
-    void step_rk2(const double dt, DGVector<DG>& phi);
+    void step_rk2(const double dt, const std::vector<DGVector<DG>*>& phi);
 
     /*!
      * Performs one time step transporting phi with the 2nd Order Heun Scheme
      *
-     * @params phi is the vector of values to be transported
+     * @params phi are the vectors of values to be transported
      */
-    void step_rk3(const double dt, DGVector<DG>& phi);
+    void step_rk3(const double dt, const std::vector<DGVector<DG>*>& phi);
+
+    //! Returns pointers to ntracers temporary vectors, allocating them if required
+    std::vector<DGVector<DG>*> temporaries(std::vector<DGVector<DG>>& tmp, const size_t ntracers);
 
 public:
 
-  DGTransport(const ParametricMesh& mesh)
+  /*!
+   * @param mesh The mesh, which must already be initialized.
+   * @param matrixfree If true, the cell terms and the inverse mass matrices
+   *                   are computed on the fly instead of being stored.
+   */
+  DGTransport(const ParametricMesh& mesh, const bool matrixfree = false)
       : smesh(mesh),
-	parammap(mesh)	  
+	parammap(mesh, matrixfree)	  
         , timesteppingscheme("rk2")
     {
         if (!(smesh.nelements > 0)) {
@@ -86,11 +104,6 @@ public:
         velx.resize_by_mesh(smesh);
         vely.resize_by_mesh(smesh);
 
-        // resize tmp-vectors for time stepping
-        tmp1.resize_by_mesh(smesh);
-        tmp2.resize_by_mesh(smesh);
-        tmp3.resize_by_mesh(smesh);
-
         // resize vectors to store the normal-velocity on the edges
         normalvel_Y.resize_by_mesh(smesh, EdgeType::Y);
         normalvel_X.resize_by_mesh(smesh, EdgeType::X);
@@ -98,6 +111,7 @@ public:
 	// initialize the mapping and set up required matrices
 	parammap.InitializeAdvectionCellTerms();
 	parammap.InitializeInverseDGMassMatrix();
+	parammap.InitializeL2Projection();
     }
 
     // Access members
@@ -119,6 +133,34 @@ public:
         return vely;
     }
 
+    /*!
+     * Sets the safety factor of the automatic sub-stepping. Each time step is
+     * split into the smallest number of equal sub-steps for which the Courant
+     * number is at most the safety factor times the stability limit 1/(2p+1)
+     * of the Runge-Kutta dG scheme of degree p. Zero disables the sub-stepping.
+     */
+    void setCFLSafety(const double safety)
+    {
+        assert(safety >= 0.);
+        cflsafety = safety;
+    }
+    //! Returns the Courant number of the last time step, before sub-stepping
+    double GetCFL() const
+    {
+        return lastcfl;
+    }
+    //! Returns the number of sub-steps of the last time step
+    size_t GetSubsteps() const
+    {
+        return lastsubsteps;
+    }
+
+    //! The precomputed matrices of the mesh, also used for projections to the dG space
+    const ParametricTransportMap<DG>& GetParametricMap() const
+    {
+        return parammap;
+    }
+
     // High level functions
     void settimesteppingscheme(const std::string tss)
     {
@@ -129,7 +171,8 @@ public:
     /*!
      * Sets the normal-velocity vector on the edges
      * The normal velocity is scaled with the length of the edge,
-     * this already serves as the integraiton weight
+     * this already serves as the integraiton weight.
+     * Also updates the rate from which the Courant number is computed.
      */
     void reinitnormalvelocity();
 
@@ -142,33 +185,44 @@ public:
     void prepareAdvection(const CGVector<CG>& cg_vx, const CGVector<CG>& cg_vy);
 
     /*!
-     * Performs one time step transporting phi
+     * Performs one time step transporting phi, split into sub-steps if the
+     * Courant number requires it (see setCFLSafety)
      *
      * @params phi is the vector of values to be transported
      */
     void step(const double dt, DGVector<DG>& phi);
 
+    /*!
+     * Performs one time step transporting several tracers with the same
+     * velocity. Each element and edge is visited once for all the tracers,
+     * such that the velocity in the quadrature points and the cell-term
+     * matrices are only computed once.
+     *
+     * @params phi are the vectors of values to be transported
+     */
+    void step(const double dt, const std::vector<DGVector<DG>*>& phi);
+
 
 private:
   /*!
    * Several internal functions 
    */
 
-  //! computes all integrals on the elements and the edges
+  //! computes all integrals on the elements and the edges for all the tracers
   void DGTransportOperator(const ParametricMesh& smesh, const double dt,
 							  const DGVector<DG>& vx,
 							  const DGVector<DG>& vy,
 							  const EdgeVector<EDGEDOFS(DG)>& normalvel_X,
 							  const EdgeVector<EDGEDOFS(DG)>& normalvel_Y,
-							  const DGVector<DG>& phi, DGVector<DG>& phiup);
+							  const std::vector<DGVector<DG>*>& phi, const std::vector<DGVector<DG>*>& phiup);
 
-  void edge_term_X(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup, const DGVector<DG>& phi, 
+  void edge_term_X(const ParametricMesh& smesh, const double dt, const std::vector<DGVector<DG>*>& phiup, const std::vector<DGVector<DG>*>& phi, 
 		   const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c1, const size_t c2, const size_t ie);
-  void edge_term_Y(const ParametricMesh& smesh, const double dt, DGVector<DG>& phiup, const DGVector<DG>& phi, 
+  void edge_term_Y(const ParametricMesh& smesh, const double dt, const std::vector<DGVector<DG>*>& phiup, const std::vector<DGVector<DG>*>& phi, 
 		   const EdgeVector<EDGEDOFS(DG)>& normalvel_Y, const size_t c1, const size_t c2, const size_t ie);
     
   void cell_term(const ParametricMesh& smesh, double dt,
-		 DGVector<DG>& phiup, const DGVector<DG>& phi,
+		 const std::vector<DGVector<DG>*>& phiup, const std::vector<DGVector<DG>*>& phi,
 		 const DGVector<DG>& vx,
 		 const DGVector<DG>& vy, const size_t ic);
   
@@ -25,6 +25,7 @@
 #include "CGModelArray.hpp"
 #include "DGModelArray.hpp"
 #include "include/gridNames.hpp"
+#include "include/Logged.hpp"
 #include "include/Time.hpp"
 
 
@@ -60,11 +61,12 @@ public:
 
 
         //! Initialize transport
-        dgtransport = new Nextsim::DGTransport<DGadvection>(*smesh);
+        dgtransport = new Nextsim::DGTransport<DGadvection>(*smesh, matrixFree);
         dgtransport->settimesteppingscheme("rk2");
+        dgtransport->setCFLSafety(advectionCFLSafety);
 
         //! Initialize momentum
-        momentum = new Nextsim::CGParametricMomentum<CGdegree>(*smesh);
+        momentum = new Nextsim::CGParametricMomentum<CGdegree>(*smesh, matrixFree);
 
 
         //! initialize Forcing 
@@ -212,11 +214,11 @@ public:
             return DGModelArray::dg2ma(cice, data);
         } else if (name == uName) {
             DGVector<DGadvection> utmp(*smesh);
-            Nextsim::Interpolations::CG2DG(*smesh, utmp, u);
+            Nextsim::Interpolations::CG2DG(*smesh, utmp, u, dgtransport->GetParametricMap());
             return DGModelArray::dg2ma(utmp, data);
         } else if (name == vName) {
             DGVector<DGadvection> vtmp(*smesh);
-            Nextsim::Interpolations::CG2DG(*smesh, vtmp, v);
+            Nextsim::Interpolations::CG2DG(*smesh, vtmp, v, dgtransport->GetParametricMap());
             return DGModelArray::dg2ma(vtmp, data);
         } else {
             // Any other named field must exist
@@ -249,6 +251,36 @@ public:
         }
     }
     
+    /*!
+     * @brief Sets the termination criteria of the mEVP iteration.
+     *
+     * @param tolerance The iteration stops once the largest change in the
+     *                  velocity components in one iteration is below this
+     *                  value (m s⁻¹). Zero or less runs maxIterations.
+     * @param minIterations The minimum number of iterations.
+     * @param maxIterations The maximum number of iterations.
+     */
+    void setmEVPIterations(double tolerance, size_t minIterations, size_t maxIterations)
+    {
+        mevpTolerance = tolerance;
+        mevpMinIterations = minIterations;
+        NT_evp = maxIterations;
+    }
+
+    /*!
+     * Sets whether the element matrices of the transport and momentum
+     * operators are computed on the fly instead of being stored. Must be
+     * called before initialisation().
+     */
+    void setMatrixFree(bool mf) { matrixFree = mf; }
+
+    /*!
+     * Sets the safety factor of the automatic advection sub-stepping, see
+     * DGTransport::setCFLSafety. Zero disables the sub-stepping. Must be
+     * called before initialisation().
+     */
+    void setAdvectionCFLSafety(double safety) { advectionCFLSafety = safety; }
+
     void update(const TimestepTime& tst) {
 
         static int step_number=0;
@@ -276,15 +308,21 @@ public:
                 momentum->GetAtmx(), momentum->GetAtmy(), *smesh);
     
             Nextsim::VTK::write_dg(resultsdir + "/Shear", step_number / vtk_out, 
-            Nextsim::Tools::Shear(*smesh, momentum->GetE11(), momentum->GetE12(), momentum->GetE22()), *smesh);
+            Nextsim::Tools::Shear(*smesh, momentum->GetE11(), momentum->GetE12(), momentum->GetE22(),
+                dgtransport->GetParametricMap()), *smesh);
 
         }
 
         //! Perform transport step
         dgtransport->prepareAdvection(momentum->GetVx(), momentum->GetVy());
 
-        dgtransport->step(tst.step.seconds(), cice);	    
-        dgtransport->step(tst.step.seconds(), hice);
+        // all the tracers are transported together in one pass over the mesh
+        std::vector<DGVector<DGadvection>*> tracers = { &cice, &hice };
+        for (auto& field : advectedFields)
+            tracers.push_back(&field.second);
+        dgtransport->step(tst.step.seconds(), tracers);
+        Logged::debug("Dynamics: advection in " + std::to_string(dgtransport->GetSubsteps())
+            + " sub-steps, Courant number " + std::to_string(dgtransport->GetCFL()));
 
         //! Gauss-point limiting
         Nextsim::LimitMax(cice, 1.0);
@@ -294,9 +332,22 @@ public:
         
         momentum->prepareIteration(hice, cice);
         //! Momentum
-        for (size_t mevpstep = 0; mevpstep < NT_evp; ++mevpstep) {
-	        momentum->mEVPStep(VP, NT_evp, alpha, beta, tst.step.seconds(), hice, cice);
+        // the change in velocity is only measured when it can stop the iteration
+        const bool converging = mevpTolerance > 0;
+        size_t mevpstep = 0;
+        double change = 0.;
+        while (mevpstep < NT_evp) {
+	        change = momentum->mEVPStep(VP, NT_evp, alpha, beta, tst.step.seconds(), hice, cice, converging);
+	        ++mevpstep;
+	        // Stop early once the velocity has converged
+	        if (converging && mevpstep >= mevpMinIterations && change < mevpTolerance)
+	            break;
 	    }
+        if (converging)
+            Logged::debug("Dynamics: " + std::to_string(mevpstep)
+                + " mEVP iterations, final velocity change " + std::to_string(change) + " m s⁻¹");
+        else
+            Logged::debug("Dynamics: " + std::to_string(mevpstep) + " mEVP iterations");
 
         step_number++;
         
@@ -322,6 +373,13 @@ private:
     double alpha = 1500.0;
     double beta = 1500.0;
     size_t NT_evp = 100;
+    //! mEVP convergence tolerance, with zero for a fixed number of iterations
+    double mevpTolerance = 0.;
+    size_t mevpMinIterations = 1;
+    //! Compute the element matrices on the fly rather than storing them
+    bool matrixFree = false;
+    //! Safety factor of the advection sub-stepping, with zero for no sub-stepping
+    double advectionCFLSafety = 0.;
 
     std::unordered_map<std::string, DGVector<DGadvection>> advectedFields;
 
@@ -7,6 +7,7 @@
 #ifndef __INTERPOLATIONS_HPP
 #define __INTERPOLATIONS_HPP
 
+#include "ParametricMap.hpp"
 #include "cgVector.hpp"
 #include "dgVector.hpp"
 
@@ -23,7 +24,8 @@
  * DG to CG will average the values on the edges and the vertices
  *
  * Projections are performed as L2-projectio such that the local
- * DG mass matrix must in inverted.
+ * DG mass matrix must in inverted. The overloads taking the transport map
+ * use its precomputed projection matrices instead.
  */
 
 namespace Nextsim {
@@ -45,6 +47,9 @@ namespace Interpolations {
     //! L2-Projection of CG-vector to a DG vector in Cartesian or Spherical coordinates
     template <int CG, int DG>
     void CG2DG(const ParametricMesh& smesh, DGVector<DG>& dest, const CGVector<CG>& src);
+    template <int CG, int DG>
+    void CG2DG(const ParametricMesh& smesh, DGVector<DG>& dest, const CGVector<CG>& src,
+        const ParametricTransportMap<DG>& map);
     //! Interpolation of DG-vector to a CG vector. Just averaging on edges / nodes
     template <int CG, int DG>
     void DG2CG(const ParametricMesh& smesh, CGVector<CG>& dest, const DGVector<DG>& src);
@@ -11,9 +11,62 @@
 #include "NextsimDynamics.hpp"
 #include "cgVector.hpp"
 
+#include <Eigen/StdVector>
+#include <memory>
+#include <vector>
+
 namespace Nextsim
 {
 
+  /*!
+   * Groups the elements of the mesh into classes of elements with the same
+   * geometry, such that all precomputed matrices are equal within one class.
+   *
+   * In Cartesian coordinates two elements are equivalent if they are
+   * translations of each other. In spherical coordinates the matrices depend
+   * on the latitude, so only translations in longitude are equivalent.
+   * On a uniform Cartesian mesh there is a single class.
+   */
+  struct ElementClasses
+  {
+    //! The class of each element
+    std::vector<size_t> classOf;
+    //! One element of each class, used to compute the matrices of the class
+    std::vector<size_t> representatives;
+
+    ElementClasses(const ParametricMesh& smesh);
+
+    size_t size() const { return representatives.size(); }
+  };
+
+  /*!
+   * Stores one matrix per class of equivalent elements. Access by element
+   * index returns the matrix of the class of the element.
+   */
+  template<typename Matrix>
+  class ElementMatrices
+  {
+    std::shared_ptr<const ElementClasses> classes;
+
+  public:
+    //! The matrix of each class
+    std::vector<Matrix, Eigen::aligned_allocator<Matrix>> matrices;
+
+    //! Sets the classes and allocates one matrix for each
+    void resize(const std::shared_ptr<const ElementClasses>& elementClasses)
+    {
+      classes = elementClasses;
+      matrices.resize(classes->size());
+    }
+    void clear()
+    {
+      classes.reset();
+      matrices.clear();
+    }
+
+    const Matrix& operator[](const size_t eid) const { return matrices[classes->classOf[eid]]; }
+  };
+
   /*!
    * Stores precomputed matrices and stencils that are required
    * for the advection. 
@@ -28,15 +81,31 @@ namespace Nextsim
 
   public:
 
+    /*!
+     * If set, no matrices are stored and the transport computes the cell terms
+     * and the inverse mass matrix on the fly (see SumFactorisation.hpp)
+     */
+    const bool matrixfree;
+
+    //! The classes of equivalent elements, shared by all the matrices
+    std::shared_ptr<const ElementClasses> classes;
+
     //! These terms are required for the cell-term in the advection  -(vA, nabla PHI)
-    std::vector< Eigen::Matrix<Nextsim::FloatType, DG, GAUSSPOINTS(DG) > > AdvectionCellTermX;
-    std::vector< Eigen::Matrix<Nextsim::FloatType, DG, GAUSSPOINTS(DG) > > AdvectionCellTermY;
+    ElementMatrices< Eigen::Matrix<Nextsim::FloatType, DG, GAUSSPOINTS(DG) > > AdvectionCellTermX;
+    ElementMatrices< Eigen::Matrix<Nextsim::FloatType, DG, GAUSSPOINTS(DG) > > AdvectionCellTermY;
 
     //! The inverse of the dG mass matrix
-    std::vector< Eigen::Matrix<Nextsim::FloatType, DG, DG> > InverseDGMassMatrix;
+    ElementMatrices< Eigen::Matrix<Nextsim::FloatType, DG, DG> > InverseDGMassMatrix;
+
+    /*!
+     * The L2 projection of values in the Gauss points to the dG space,
+     * M^-1 J w PSI_i(q), including the metric term in spherical coordinates.
+     * Used by the Interpolations and Tools.
+     */
+    ElementMatrices< Eigen::Matrix<Nextsim::FloatType, DG, GAUSSPOINTS(DG) > > L2Projection;
     
 
-    ParametricTransportMap(const ParametricMesh& sm) : smesh(sm)
+    ParametricTransportMap(const ParametricMesh& sm, const bool mf = false) : smesh(sm), matrixfree(mf)
     {}
 
     //! initialization of the different forms
@@ -55,7 +124,9 @@ namespace Nextsim
      * R^2 (v',phi) - R (vA, nabla phi) + R <va * N, phi> = 0
      */
     void InitializeInverseDGMassMatrix();
-     
+
+    //! For the projections in Interpolations and Tools. Fills L2Projection
+    void InitializeL2Projection();
   };
 
 
@@ -78,35 +149,41 @@ namespace Nextsim
     //! Vector to store the lumpes mass matrix. Is directly initialized when the mesh is known
     CGVector<CG> lumpedcgmass;
 
+    /*!
+     * If set, no matrices are stored and the strain, the stress update and
+     * the divergence of the stress are computed on the fly (see SumFactorisation.hpp)
+     */
+    const bool matrixfree;
+
+    //! The classes of equivalent elements, shared by all the matrices
+    std::shared_ptr<const ElementClasses> classes;
+
     /*!
      * These matrices realize the integration of (-div S, phi) = (S, nabla phi)
      * as matrix-vector producs (divS1 * S11 + divS2 * S12 ; divS1 * S21 + divS2 * S22)
      * [ where S12= S21 ]
      * divM is in addition required for spherical coordinates
      */
-    std::vector<Eigen::Matrix<Nextsim::FloatType, CGDOFS(CG),CG2DGSTRESS(CG)>,
-		Eigen::aligned_allocator<Eigen::Matrix<Nextsim::FloatType, CGDOFS(CG), CG2DGSTRESS(CG)>>>
+    ElementMatrices<Eigen::Matrix<Nextsim::FloatType, CGDOFS(CG),CG2DGSTRESS(CG)>>
     divS1, divS2, divM;
 
         /*!
      * These matrices realize the integration of (E, \grad phi) scaled with the
      * inverse mass matrix;
      */
-    std::vector<Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), CGDOFS(CG)>,
-		Eigen::aligned_allocator<Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), CGDOFS(CG)>>>
+    ElementMatrices<Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), CGDOFS(CG)>>
     iMgradX, iMgradY, iMM;
 
     /*!
      * These matrices are M^-1 J w PSI_i(q)
      * Multiplied
      */
-    std::vector<Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), GAUSSPOINTS(CG2DGSTRESS(CG))>,
-      Eigen::aligned_allocator<Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), GAUSSPOINTS(CG2DGSTRESS(CG))>>>
+    ElementMatrices<Eigen::Matrix<Nextsim::FloatType, CG2DGSTRESS(CG), GAUSSPOINTS(CG2DGSTRESS(CG))>>
         iMJwPSI;
 
     
     
-    ParametricMomentumMap(const ParametricMesh& sm) : smesh(sm)
+    ParametricMomentumMap(const ParametricMesh& sm, const bool mf = false) : smesh(sm), matrixfree(mf)
     {}
 
     //! initialization of the different forms
@@ -0,0 +1,335 @@
+/*!
+ * @file    SumFactorisation.hpp
+ * @date    Oct 17, 2026
+ * @author  Tim Spain <timothy.spain@nersc.no>
+ */
+
+#ifndef __SUMFACTORISATION_HPP
+#define __SUMFACTORISATION_HPP
+
+#include <Eigen/Dense>
+
+#include "NextsimDynamics.hpp"
+#include "ParametricMesh.hpp"
+#include "codeGenerationCGinGauss.hpp"
+#include "codeGenerationDGinGauss.hpp"
+
+#include <cmath>
+
+/*!
+ * Matrix-free evaluation of the DG and CG basis functions in the Gauss
+ * points of an element by sum factorisation.
+ *
+ * All basis functions are products of one-dimensional functions,
+ *   DG: psi_j(x,y) = l_{a_j}(x) l_{b_j}(y) with the Legendre polynomials
+ *       l_0 = 1, l_1 = x-1/2, l_2 = (x-1/2)^2 - 1/12
+ *   CG: phi_i(x,y) = p_{i%(CG+1)}(x) p_{i/(CG+1)}(y) with the Lagrange polynomials
+ * and the Gauss points form a tensor product with the x-index running
+ * fastest. Evaluations and integrations therefore contract one direction at
+ * a time, which only requires the one-dimensional tables and no matrices
+ * depending on the element.
+ */
+
+namespace Nextsim {
+
+namespace SumFactorisation {
+
+    //! Degrees of the x- and y-Legendre polynomials of the DG basis functions
+    constexpr int DGXDEGREE[8] = { 0, 1, 0, 2, 0, 1, 2, 1 };
+    constexpr int DGYDEGREE[8] = { 0, 0, 1, 0, 2, 1, 1, 2 };
+
+    //! Inverse of the diagonal entries of the DG mass matrix on the unit square
+    constexpr double DGINVERSEMASS[8] = { 1., 12., 12., 180., 180., 144., 2160., 2160. };
+
+    //! Returns the q-th one-dimensional Gauss point on [0,1]
+    template <int NGP>
+    inline double gaussPoint1D(const int q)
+    {
+        static_assert(NGP >= 1 && NGP <= 4, "Only 1 to 4 Gauss points are supported");
+        if constexpr (NGP == 1)
+            return gauss_points1[q];
+        else if constexpr (NGP == 2)
+            return gauss_points2[q];
+        else if constexpr (NGP == 3)
+            return gauss_points3[q];
+        else
+            return gauss_points4[q];
+    }
+
+    /*!
+     * The Legendre polynomials (value) and their derivatives (dx) in the
+     * one-dimensional Gauss points. Entry (a, q) is l_a(x_q).
+     */
+    template <int NGP>
+    struct Legendre1D {
+        static inline const Eigen::Matrix<double, 3, NGP> value = [] {
+            Eigen::Matrix<double, 3, NGP> m;
+            for (int q = 0; q < NGP; ++q) {
+                const double x = gaussPoint1D<NGP>(q) - 0.5;
+                m(0, q) = 1.0;
+                m(1, q) = x;
+                m(2, q) = x * x - 1.0 / 12.0;
+            }
+            return m;
+        }();
+        static inline const Eigen::Matrix<double, 3, NGP> dx = [] {
+            Eigen::Matrix<double, 3, NGP> m;
+            for (int q = 0; q < NGP; ++q) {
+                m(0, q) = 0.0;
+                m(1, q) = 1.0;
+                m(2, q) = 2.0 * (gaussPoint1D<NGP>(q) - 0.5);
+            }
+            return m;
+        }();
+    };
+
+    /*!
+     * The Lagrange polynomials of degree CG (value) and their derivatives (dx)
+     * in the one-dimensional Gauss points. Entry (i, q) is p_i(x_q).
+     */
+    template <int CG, int NGP>
+    struct Lagrange1D {
+        static_assert(CG == 1 || CG == 2, "Only CG1 and CG2 are supported");
+        static inline const Eigen::Matrix<double, CG + 1, NGP> value = [] {
+            Eigen::Matrix<double, CG + 1, NGP> m;
+            for (int q = 0; q < NGP; ++q) {
+                const double x = gaussPoint1D<NGP>(q);
+                if (CG == 1) {
+                    m(0, q) = 1.0 - x;
+                    m(1, q) = x;
+                } else {
+                    m(0, q) = 2.0 * (x - 0.5) * (x - 1.0);
+                    m(1, q) = 4.0 * x * (1.0 - x);
+                    m(CG, q) = 2.0 * x * (x - 0.5);
+                }
+            }
+            return m;
+        }();
+        static inline const Eigen::Matrix<double, CG + 1, NGP> dx = [] {
+            Eigen::Matrix<double, CG + 1, NGP> m;
+            for (int q = 0; q < NGP; ++q) {
+                const double x = gaussPoint1D<NGP>(q);
+                if (CG == 1) {
+                    m(0, q) = -1.0;
+                    m(1, q) = 1.0;
+                } else {
+                    m(0, q) = 4.0 * x - 3.0;
+                    m(1, q) = 4.0 - 8.0 * x;
+                    m(CG, q) = 4.0 * x - 1.0;
+                }
+            }
+            return m;
+        }();
+    };
+
+    /*!
+     * Evaluates the DG function with coefficients c in the NGP x NGP Gauss
+     * points. Equivalent to c * PSI<DG, NGP>.
+     */
+    template <int DG, int NGP, typename Derived>
+    inline Eigen::Matrix<double, 1, NGP * NGP> evaluateDG(const Eigen::MatrixBase<Derived>& c)
+    {
+        const auto& L = Legendre1D<NGP>::value;
+        // contract the x-direction: t(b, qx) = sum_{j : b_j = b} c_j l_{a_j}(x_qx)
+        Eigen::Matrix<double, 3, NGP> t = Eigen::Matrix<double, 3, NGP>::Zero();
+        for (int j = 0; j < DG; ++j)
+            t.row(DGYDEGREE[j]) += c(j) * L.row(DGXDEGREE[j]);
+        // and the y-direction
+        Eigen::Matrix<double, 1, NGP * NGP> u;
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx)
+                u(NGP * qy + qx) = t.col(qx).dot(L.col(qy));
+        return u;
+    }
+
+    /*!
+     * Integrates the values f in the Gauss points against each DG basis
+     * function, r_j = sum_q psi_j(q) f(q). Equivalent to PSI<DG, NGP> * f^T.
+     */
+    template <int DG, int NGP>
+    inline Eigen::Matrix<double, DG, 1> integrateDG(const Eigen::Matrix<double, 1, NGP * NGP>& f)
+    {
+        const auto& L = Legendre1D<NGP>::value;
+        // contract the y-direction: t(b, qx) = sum_qy f(qy, qx) l_b(y_qy)
+        Eigen::Matrix<double, 3, NGP> t = Eigen::Matrix<double, 3, NGP>::Zero();
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx)
+                t.col(qx) += f(NGP * qy + qx) * L.col(qy);
+        // and the x-direction
+        Eigen::Matrix<double, DG, 1> r;
+        for (int j = 0; j < DG; ++j)
+            r(j) = L.row(DGXDEGREE[j]).dot(t.row(DGYDEGREE[j]));
+        return r;
+    }
+
+    /*!
+     * Integrates the values fx and fy in the Gauss points against the
+     * reference gradient of each DG basis function,
+     * r_j = sum_q dx psi_j(q) fx(q) + dy psi_j(q) fy(q).
+     * Equivalent to PSIx<DG, NGP> * fx^T + PSIy<DG, NGP> * fy^T.
+     */
+    template <int DG, int NGP>
+    inline Eigen::Matrix<double, DG, 1> integrateDGGradient(
+        const Eigen::Matrix<double, 1, NGP * NGP>& fx, const Eigen::Matrix<double, 1, NGP * NGP>& fy)
+    {
+        const auto& L = Legendre1D<NGP>::value;
+        const auto& dL = Legendre1D<NGP>::dx;
+        Eigen::Matrix<double, 3, NGP> tx = Eigen::Matrix<double, 3, NGP>::Zero();
+        Eigen::Matrix<double, 3, NGP> ty = Eigen::Matrix<double, 3, NGP>::Zero();
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx) {
+                tx.col(qx) += fx(NGP * qy + qx) * L.col(qy);
+                ty.col(qx) += fy(NGP * qy + qx) * dL.col(qy);
+            }
+        Eigen::Matrix<double, DG, 1> r;
+        for (int j = 0; j < DG; ++j)
+            r(j) = dL.row(DGXDEGREE[j]).dot(tx.row(DGYDEGREE[j]))
+                + L.row(DGXDEGREE[j]).dot(ty.row(DGYDEGREE[j]));
+        return r;
+    }
+
+    /*!
+     * Evaluates the CG function with the local coefficients v in the Gauss
+     * points. Equivalent to v^T * PHI<CG, NGP>.
+     */
+    template <int CG, int NGP>
+    inline Eigen::Matrix<double, 1, NGP * NGP> evaluateCG(
+        const Eigen::Matrix<double, CGDOFS(CG), 1>& v)
+    {
+        const auto& P = Lagrange1D<CG, NGP>::value;
+        // t(iy, qx) = sum_ix v(iy, ix) p_ix(x_qx)
+        Eigen::Matrix<double, CG + 1, NGP> t;
+        for (int iy = 0; iy <= CG; ++iy)
+            t.row(iy) = v.template segment<CG + 1>((CG + 1) * iy).transpose() * P;
+        Eigen::Matrix<double, 1, NGP * NGP> u;
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx)
+                u(NGP * qy + qx) = t.col(qx).dot(P.col(qy));
+        return u;
+    }
+
+    /*!
+     * Evaluates the reference gradient of the CG function with the local
+     * coefficients v in the Gauss points. Equivalent to v^T * PHIx<CG, NGP>
+     * and v^T * PHIy<CG, NGP>.
+     */
+    template <int CG, int NGP>
+    inline void evaluateCGGradient(const Eigen::Matrix<double, CGDOFS(CG), 1>& v,
+        Eigen::Matrix<double, 1, NGP * NGP>& vx, Eigen::Matrix<double, 1, NGP * NGP>& vy)
+    {
+        const auto& P = Lagrange1D<CG, NGP>::value;
+        const auto& dP = Lagrange1D<CG, NGP>::dx;
+        Eigen::Matrix<double, CG + 1, NGP> tdx, t;
+        for (int iy = 0; iy <= CG; ++iy) {
+            tdx.row(iy) = v.template segment<CG + 1>((CG + 1) * iy).transpose() * dP;
+            t.row(iy) = v.template segment<CG + 1>((CG + 1) * iy).transpose() * P;
+        }
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx) {
+                vx(NGP * qy + qx) = tdx.col(qx).dot(P.col(qy));
+                vy(NGP * qy + qx) = t.col(qx).dot(dP.col(qy));
+            }
+    }
+
+    /*!
+     * Integrates the values f in the Gauss points against each CG basis
+     * function and, if given, fx and fy against the reference gradients,
+     * r_i = sum_q phi_i(q) f(q) + dx phi_i(q) fx(q) + dy phi_i(q) fy(q).
+     */
+    template <int CG, int NGP>
+    inline Eigen::Matrix<double, CGDOFS(CG), 1> integrateCGGradient(
+        const Eigen::Matrix<double, 1, NGP * NGP>& fx, const Eigen::Matrix<double, 1, NGP * NGP>& fy)
+    {
+        const auto& P = Lagrange1D<CG, NGP>::value;
+        const auto& dP = Lagrange1D<CG, NGP>::dx;
+        // contract the y-direction
+        Eigen::Matrix<double, CG + 1, NGP> tx = Eigen::Matrix<double, CG + 1, NGP>::Zero();
+        Eigen::Matrix<double, CG + 1, NGP> ty = Eigen::Matrix<double, CG + 1, NGP>::Zero();
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx) {
+                tx.col(qx) += fx(NGP * qy + qx) * P.col(qy);
+                ty.col(qx) += fy(NGP * qy + qx) * dP.col(qy);
+            }
+        // and the x-direction
+        Eigen::Matrix<double, CGDOFS(CG), 1> r;
+        for (int iy = 0; iy <= CG; ++iy)
+            r.template segment<CG + 1>((CG + 1) * iy)
+                = dP * tx.row(iy).transpose() + P * ty.row(iy).transpose();
+        return r;
+    }
+    template <int CG, int NGP>
+    inline Eigen::Matrix<double, CGDOFS(CG), 1> integrateCGGradient(
+        const Eigen::Matrix<double, 1, NGP * NGP>& f,
+        const Eigen::Matrix<double, 1, NGP * NGP>& fx, const Eigen::Matrix<double, 1, NGP * NGP>& fy)
+    {
+        const auto& P = Lagrange1D<CG, NGP>::value;
+        Eigen::Matrix<double, CG + 1, NGP> t = Eigen::Matrix<double, CG + 1, NGP>::Zero();
+        for (int qy = 0; qy < NGP; ++qy)
+            for (int qx = 0; qx < NGP; ++qx)
+                t.col(qx) += f(NGP * qy + qx) * P.col(qy);
+        Eigen::Matrix<double, CGDOFS(CG), 1> r = integrateCGGradient<CG, NGP>(fx, fy);
+        for (int iy = 0; iy <= CG; ++iy)
+            r.template segment<CG + 1>((CG + 1) * iy) += P * t.row(iy).transpose();
+        return r;
+    }
+
+    /*!
+     * Applies the inverse of the DG mass matrix with the density m in the
+     * Gauss points, M_ij = sum_q psi_i(q) psi_j(q) m(q). The density contains
+     * the Gauss weights and the Jacobian determinant.
+     *
+     * If m is a constant multiple of the Gauss weights, as on parallelogram
+     * elements in Cartesian coordinates, the mass matrix is diagonal, since
+     * the basis is orthogonal. Otherwise the mass matrix is assembled and
+     * factorised.
+     */
+    template <int DG, int NGP>
+    inline Eigen::Matrix<double, DG, 1> applyInverseMass(
+        const Eigen::Matrix<double, 1, NGP * NGP>& m, const Eigen::Matrix<double, DG, 1>& rhs)
+    {
+        const Eigen::Array<double, 1, NGP * NGP> scale = m.array() / GAUSSWEIGHTS<NGP>.array();
+        if (scale.maxCoeff() - scale.minCoeff() <= 1.e-12 * std::abs(scale(0))) {
+            Eigen::Matrix<double, DG, 1> r;
+            for (int j = 0; j < DG; ++j)
+                r(j) = rhs(j) * DGINVERSEMASS[j] / scale(0);
+            return r;
+        }
+        const Eigen::Matrix<double, DG, DG> mass
+            = (PSI<DG, NGP>.array().rowwise() * m.array()).matrix() * PSI<DG, NGP>.transpose();
+        return mass.llt().solve(rhs);
+    }
+
+    /*!
+     * The geometry of one element in the Gauss points, computed on the fly
+     * from the coordinates of its vertices.
+     */
+    template <int NGP>
+    struct ElementGeometry {
+        //! Gradient of the parametric map (dx T1, dx T2) and (dy T1, dy T2) times the Gauss weights
+        Eigen::Matrix<double, 2, NGP * NGP> Fx, Fy;
+        //! Determinant of the Jacobian of the parametric map
+        Eigen::Matrix<double, 1, NGP * NGP> J;
+        //! Cosine and sine of the latitude. Only set in spherical coordinates.
+        Eigen::Matrix<double, 1, NGP * NGP> cos_lat, sin_lat;
+
+        ElementGeometry(const ParametricMesh& smesh, const size_t eid)
+        {
+            const Eigen::Matrix<Nextsim::FloatType, 4, 2> coordinates = smesh.coordinatesOfElement(eid);
+            const Eigen::Matrix<double, 2, NGP * NGP> dxT = coordinates.transpose() * PHIx<1, NGP>;
+            const Eigen::Matrix<double, 2, NGP * NGP> dyT = coordinates.transpose() * PHIy<1, NGP>;
+            J = dxT.array().row(0) * dyT.array().row(1) - dxT.array().row(1) * dyT.array().row(0);
+            Fx = dxT.array().rowwise() * GAUSSWEIGHTS<NGP>.array();
+            Fy = dyT.array().rowwise() * GAUSSWEIGHTS<NGP>.array();
+            if (smesh.CoordinateSystem == SPHERICAL) {
+                const Eigen::Matrix<double, 1, NGP * NGP> lat = (coordinates.transpose() * PHI<1, NGP>).row(1);
+                cos_lat = lat.array().cos();
+                sin_lat = lat.array().sin();
+            }
+        }
+    };
+
+} /* namespace SumFactorisation */
+
+} /* namespace Nextsim */
+
+#endif /* __SUMFACTORISATION_HPP */
@@ -7,6 +7,7 @@
 #ifndef __TOOLS_HPP
 #define __TOOLS_HPP
 
+#include "ParametricMap.hpp"
 #include "ParametricTools.hpp"
 #include "codeGenerationDGinGauss.hpp"
 #include "dgVector.hpp"
@@ -102,6 +103,40 @@ namespace Tools {
 	    }
         }
 
+#undef NGP
+
+        return SHEAR;
+    }
+
+    /*!
+     * Shear using the precomputed projection of the transport map, with the
+     * Gauss rule of the map. The projection of the map includes the metric
+     * term, so spherical meshes use the version above.
+     */
+    template <int DGs>
+    DGVector<S2A(DGs)> Shear(const ParametricMesh& smesh, const DGVector<DGs>& E11, const DGVector<DGs>& E12,
+        const DGVector<DGs>& E22, const ParametricTransportMap<S2A(DGs)>& map)
+    {
+        if (map.matrixfree || smesh.CoordinateSystem != CARTESIAN)
+            return Shear(smesh, E11, E12, E22);
+
+        DGVector<S2A(DGs)> SHEAR(smesh);
+
+#define NGP GAUSSPOINTS1D(S2A(DGs))
+#pragma omp parallel for
+        for (size_t i = 0; i < smesh.nelements; ++i) {
+	  if (smesh.landmask[i]==0)
+	    SHEAR.row(i).setZero();
+	  else
+	    {
+	      const LocalEdgeVector<NGP* NGP> e11_gauss = E11.row(i) * PSI<DGs, NGP>;
+	      const LocalEdgeVector<NGP* NGP> e12_gauss = E12.row(i) * PSI<DGs, NGP>;
+	      const LocalEdgeVector<NGP* NGP> e22_gauss = E22.row(i) * PSI<DGs, NGP>;
+
+	      SHEAR.row(i) = map.L2Projection[i] * (((e11_gauss.array() - e22_gauss.array()).square() + 4.0 * e12_gauss.array().square()+1.e-20).sqrt().log10()).matrix().transpose();
+	    }
+        }
+
 #undef NGP
 
         return SHEAR;
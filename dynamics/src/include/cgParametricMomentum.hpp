@@ -26,13 +26,12 @@ class CGParametricMomentum {
 private:
     const ParametricMesh& smesh; //!< const-reference to the mesh
 
-  
+public:
     /*!
      * Stores precomputed values for efficient numerics on transformed mesh
      * accelerates numerics but substantial memory effort!
+     * Unless it is set to be matrix free, then everything is computed on the fly.
      */
-    static constexpr int precompute_matrices = 1;
-public:
   ParametricMomentumMap<CG> pmap;
 
     //! vectors storing the velocity (node-wise)
@@ -52,6 +51,9 @@ public:
     //! old velocities. They are required during temporary vectors. Maybe we can remove them?
     CGVector<CG> vx_mevp, vy_mevp;
 
+    //! zero on the nodes reset in each mEVP iteration, one elsewhere
+    CGVector<CG> free_nodes;
+
 
     //! Vector to store the CG-Version of ice concentration and ice height
     CGVector<CG> cg_A, cg_H, cg_D;
@@ -61,8 +63,13 @@ public:
     DGVector<CG2DGSTRESS(CG)> S11, S12, S22;
 
 public:
-  CGParametricMomentum(const ParametricMesh& sm)
-    : smesh(sm), pmap(sm)
+  /*!
+   * @param sm The mesh.
+   * @param matrixfree If true, no element matrices are stored and the
+   *        operators are evaluated on the fly by sum factorisation.
+   */
+  CGParametricMomentum(const ParametricMesh& sm, const bool matrixfree = false)
+    : smesh(sm), pmap(sm, matrixfree)
     {
         if (!(smesh.nelements > 0)) {
             std::cerr << "CGParametricMomentum: The mesh has to be initialized first!" << std::endl;
@@ -95,6 +102,7 @@ public:
 
         tmpx.resize_by_mesh(smesh);
         tmpy.resize_by_mesh(smesh);
+        free_nodes.resize_by_mesh(smesh);
 
         E11.resize_by_mesh(smesh);
         E12.resize_by_mesh(smesh);
@@ -167,12 +175,16 @@ public:
     void prepareIteration(const DGVector<DG>& H, const DGVector<DG>& A,
         const DGVector<DG>& D);
 
-    //! performs one complete mEVP cycle with NT_evp subiterations
+    /*!
+     * performs one mEVP subiteration and returns the largest change
+     * of the velocity components in it, or zero if measureChange is false
+     */
     template <int DG>
-    void mEVPStep(const VPParameters& vpparameters,
+    double mEVPStep(const VPParameters& vpparameters,
         size_t NT_evp, double alpha, double beta,
         double dt_adv,
-        const DGVector<DG>& H, const DGVector<DG>& A);
+        const DGVector<DG>& H, const DGVector<DG>& A,
+        bool measureChange = true);
 
     //! performs one complete MEB timestep with NT_meb subiterations
     template <int DG>
@@ -191,6 +203,8 @@ public:
      */
     //! Projects the symmetric gradient of the CG velocity into the DG space
     void ProjectCGVelocityToDGStrain();
+    //! Projects the strain in a single element with lower left CG index cgi
+    void ProjectCGVelocityToDGStrainCell(const size_t dgi, const size_t cgi);
 
     /*!
      * Evaluates (S, nabla phi) and writes it in the tx/ty - Vector
@@ -200,6 +214,23 @@ public:
     void AddStressTensorCell(const double scale, const size_t c, const size_t cx,
         const size_t cy, CGVector<CG>& tx, CGVector<CG>& ty) const;
 
+    //! Matrix-free versions of the strain projection and the divergence in one element
+    void MatrixFreeStrainCell(const size_t dgi, const Eigen::Matrix<double, CGDOFS(CG), 1>& vx_local,
+        const Eigen::Matrix<double, CGDOFS(CG), 1>& vy_local);
+    void MatrixFreeStressTensorCell(const double scale, const size_t eid,
+        Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)>& tx, Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)>& ty) const;
+
+    /*!
+     * Computes the strain, the mEVP stress update and the divergence of
+     * the stress in a single sweep over the elements. The result is the same
+     * as ProjectCGVelocityToDGStrain, mEVP::StressUpdateHighOrder and
+     * DivergenceOfStress called in turn.
+     */
+    template <int DG>
+    void mEVPStressDivergence(const VPParameters& params, const double alpha,
+        const double scale, const DGVector<DG>& H, const DGVector<DG>& A,
+        CGVector<CG>& tx, CGVector<CG>& ty);
+
     //! Sets the velocity vector to zero along the boundary
     void DirichletZero()
     {
@@ -229,13 +260,19 @@ void CGParametricMomentum<CG>::AddStressTensorCell(const double scale, const siz
   
 #define NGP (CG == 1 ? 2 : 3) 
   
-  Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)> tx = scale * (pmap.divS1[eid] * S11.row(eid).transpose() + pmap.divS2[eid] * S12.row(eid).transpose());
-  Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)> ty = scale * (pmap.divS1[eid] * S12.row(eid).transpose() + pmap.divS2[eid] * S22.row(eid).transpose());
-
-  if (smesh.CoordinateSystem == SPHERICAL) // In spherical coordinates there is the additional 'derivative term' arising from the derivative of the units
+  Eigen::Vector<Nextsim::FloatType, CGDOFS(CG)> tx, ty;
+  if (pmap.matrixfree)
+    MatrixFreeStressTensorCell(scale, eid, tx, ty);
+  else
     {
-      tx += scale * pmap.divM[eid] * S12.row(eid).transpose();
-      ty -= scale * pmap.divM[eid] * S11.row(eid).transpose();
+      tx = scale * (pmap.divS1[eid] * S11.row(eid).transpose() + pmap.divS2[eid] * S12.row(eid).transpose());
+      ty = scale * (pmap.divS1[eid] * S12.row(eid).transpose() + pmap.divS2[eid] * S22.row(eid).transpose());
+
+      if (smesh.CoordinateSystem == SPHERICAL) // In spherical coordinates there is the additional 'derivative term' arising from the derivative of the units
+	{
+	  tx += scale * pmap.divM[eid] * S12.row(eid).transpose();
+	  ty -= scale * pmap.divM[eid] * S11.row(eid).transpose();
+	}
     }
   
   const size_t CGROW = CG * smesh.nx + 1;
@@ -7,6 +7,8 @@
 #ifndef __MEVP_HPP
 #define __MEVP_HPP
 
+#include "ParametricTools.hpp"
+#include "SumFactorisation.hpp"
 #include "VPParameters.hpp"
 #include "codeGenerationDGinGauss.hpp"
 #include "dgVector.hpp"
@@ -22,20 +24,21 @@ namespace mEVP {
 
     // Stress Update (ParametricMesh)
 
+    /*!
+     * Updates the stress in a single element. The update only uses the
+     * strain, ice height and concentration of the same element.
+     */
     template <int CG, int DGstress, int DGadvection>
-    void StressUpdateHighOrder(const VPParameters& vpparameters,
-        const ParametricMomentumMap<CG>& pmap,
-        const ParametricMesh& smesh, DGVector<DGstress>& S11, DGVector<DGstress>& S12,
+    inline void StressUpdateElement(const VPParameters& vpparameters,
+        const ParametricMomentumMap<CG>& pmap, const ParametricMesh& smesh, const size_t i,
+        DGVector<DGstress>& S11, DGVector<DGstress>& S12,
         DGVector<DGstress>& S22, const DGVector<DGstress>& E11, const DGVector<DGstress>& E12,
         const DGVector<DGstress>& E22, const DGVector<DGadvection>& H,
         const DGVector<DGadvection>& A,
-        const double alpha, const double beta)
+        const double alpha)
     {
 
 #define NGP ( ((DGstress == 8) || (DGstress == 6) ) ? 3 : (DGstress == 3 ? 2 : -1))
-        //! Stress Update
-#pragma omp parallel for
-        for (size_t i = 0; i < smesh.nelements; ++i) {
 
             // Here, one should check if it is enough to use a 2-point Gauss rule.
             // We're dealing with dG2, 3-point Gauss should be required.
@@ -89,21 +92,54 @@ namespace mEVP {
             // const Eigen::Matrix<Nextsim::FloatType, 8, 9> imass_psi = ParametricTools::massMatrix<8>(smesh, i).inverse()
             //     * (PSI<8,3>.array().rowwise() * (GAUSSWEIGHTS<3>.array() * J.array())).matrix();
 
-            S11.row(i) += pmap.iMJwPSI[i] * (1.0 / alpha * (P.array() / 8.0 / DELTA.array() * (5.0 * e11_gauss.array() + 3.0 * e22_gauss.array()) - 0.5 * P.array()).matrix().transpose());
+            const LocalEdgeVector<NGP* NGP> s11_gauss = 1.0 / alpha * (P.array() / 8.0 / DELTA.array() * (5.0 * e11_gauss.array() + 3.0 * e22_gauss.array()) - 0.5 * P.array()).matrix();
 
             //   S12.row(i) += 1.0 / alpha * (2. * eta * E12.row(i));
             // 2 eta = 2/4 * P / (2 Delta) = P / (4 Delta)
-            S12.row(i) += pmap.iMJwPSI[i] * (1.0 / alpha * (P.array() / 4.0 / DELTA.array() * e12_gauss.array()).matrix().transpose());
+            const LocalEdgeVector<NGP* NGP> s12_gauss = 1.0 / alpha * (P.array() / 4.0 / DELTA.array() * e12_gauss.array()).matrix();
 
             //   S22.row(i)
             //       += 1.0 / alpha * (2. * eta * E22.row(i) + (zeta - eta) * (E11.row(i) + E22.row(i)));
             //   S22(i, 0) -= 1.0 / alpha * 0.5 * P;
-            S22.row(i) += pmap.iMJwPSI[i] * (1.0 / alpha * (P.array() / 8.0 / DELTA.array() * (5.0 * e22_gauss.array() + 3.0 * e11_gauss.array()) - 0.5 * P.array()).matrix().transpose());
-        }
+            const LocalEdgeVector<NGP* NGP> s22_gauss = 1.0 / alpha * (P.array() / 8.0 / DELTA.array() * (5.0 * e22_gauss.array() + 3.0 * e11_gauss.array()) - 0.5 * P.array()).matrix();
+
+            if (!pmap.matrixfree) {
+                S11.row(i) += pmap.iMJwPSI[i] * s11_gauss.transpose();
+                S12.row(i) += pmap.iMJwPSI[i] * s12_gauss.transpose();
+                S22.row(i) += pmap.iMJwPSI[i] * s22_gauss.transpose();
+            } else {
+                // project with the mass matrix of the element computed on the fly
+                const LocalEdgeVector<NGP* NGP> Jw = GAUSSWEIGHTS<NGP>.cwiseProduct(ParametricTools::J<NGP>(smesh, i));
+                LocalEdgeVector<NGP* NGP> mass = Jw;
+                if (smesh.CoordinateSystem == SPHERICAL)
+                    mass = mass.cwiseProduct((ParametricTools::getGaussPointsInElement<NGP>(smesh, i).row(1).array()).cos().matrix());
+                S11.row(i) += SumFactorisation::applyInverseMass<DGstress, NGP>(mass,
+                    SumFactorisation::integrateDG<DGstress, NGP>(Jw.cwiseProduct(s11_gauss))).transpose();
+                S12.row(i) += SumFactorisation::applyInverseMass<DGstress, NGP>(mass,
+                    SumFactorisation::integrateDG<DGstress, NGP>(Jw.cwiseProduct(s12_gauss))).transpose();
+                S22.row(i) += SumFactorisation::applyInverseMass<DGstress, NGP>(mass,
+                    SumFactorisation::integrateDG<DGstress, NGP>(Jw.cwiseProduct(s22_gauss))).transpose();
+            }
 
 #undef NGP
     }
 
+    template <int CG, int DGstress, int DGadvection>
+    void StressUpdateHighOrder(const VPParameters& vpparameters,
+        const ParametricMomentumMap<CG>& pmap,
+        const ParametricMesh& smesh, DGVector<DGstress>& S11, DGVector<DGstress>& S12,
+        DGVector<DGstress>& S22, const DGVector<DGstress>& E11, const DGVector<DGstress>& E12,
+        const DGVector<DGstress>& E22, const DGVector<DGadvection>& H,
+        const DGVector<DGadvection>& A,
+        const double alpha, const double beta)
+    {
+        //! Stress Update
+#pragma omp parallel for
+        for (size_t i = 0; i < smesh.nelements; ++i) {
+            StressUpdateElement(vpparameters, pmap, smesh, i, S11, S12, S22, E11, E12, E22, H, A, alpha);
+        }
+    }
+
     template <int CG, int DGs, int DGa>
     void StressUpdateHighOrder(const VPParameters& vpparameters,
         const ParametricMesh& smesh, DGVector<DGs>& S11, DGVector<DGs>& S12,
@@ -0,0 +1,166 @@
+/*!
+ * @file DGTransport_test.cpp
+ *
+ * @brief Test the dG advection of the dynamics.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "include/DGTransport.hpp"
+
+#include "TestMesh.hpp"
+
+#include <random>
+
+namespace Nextsim {
+
+// Fills a vector with reproducible random values around offset
+template <typename Vector>
+void fillRandom(Vector& v, std::mt19937& gen, double offset, double scale)
+{
+    std::uniform_real_distribution<double> dist(-scale, scale);
+    for (long i = 0; i < v.rows(); ++i)
+        for (long j = 0; j < v.cols(); ++j)
+            v(i, j) = (j == 0 ? offset : 0.) + dist(gen);
+}
+
+template <typename Vector>
+double relativeDifference(const Vector& a, const Vector& b)
+{
+    return (a - b).norm() / b.norm();
+}
+
+/*
+ * Compares a transport step with the cell terms and inverse mass matrices
+ * computed on the fly to one with stored matrices. The edge terms are the
+ * same in both.
+ */
+template <int DG>
+void checkMatrixFree(const ParametricMesh& smesh, const std::string& scheme)
+{
+    DGTransport<DG> stored(smesh);
+    DGTransport<DG> matrixFree(smesh, true);
+    stored.settimesteppingscheme(scheme);
+    matrixFree.settimesteppingscheme(scheme);
+
+    std::mt19937 gen(7);
+    CGVector<2> vx(smesh), vy(smesh);
+    fillRandom(vx, gen, 0., 0.2);
+    fillRandom(vy, gen, 0., 0.2);
+    stored.prepareAdvection(vx, vy);
+    matrixFree.prepareAdvection(vx, vy);
+
+    DGVector<DG> phiStored(smesh);
+    fillRandom(phiStored, gen, 1., 0.1);
+    DGVector<DG> phiFree = phiStored;
+    const DGVector<DG> phi0 = phiStored;
+
+    for (int n = 0; n < 5; ++n) {
+        stored.step(2000., phiStored);
+        matrixFree.step(2000., phiFree);
+    }
+    // Check that the field was actually advected
+    REQUIRE(relativeDifference(phiStored, phi0) > 1.e-3);
+    CHECK(relativeDifference(phiFree, phiStored) < 1.e-12);
+}
+
+/*
+ * Compares several tracers transported in one step with each transported
+ * in its own step.
+ */
+template <int DG>
+void checkTracers(const ParametricMesh& smesh, const std::string& scheme)
+{
+    DGTransport<DG> transport(smesh);
+    transport.settimesteppingscheme(scheme);
+
+    std::mt19937 gen(13);
+    CGVector<2> vx(smesh), vy(smesh);
+    fillRandom(vx, gen, 0., 0.2);
+    fillRandom(vy, gen, 0., 0.2);
+    transport.prepareAdvection(vx, vy);
+
+    const size_t nTracers = 3;
+    std::vector<DGVector<DG>> together(nTracers, DGVector<DG>(smesh));
+    std::vector<DGVector<DG>*> tracers;
+    for (auto& tracer : together) {
+        fillRandom(tracer, gen, 1., 0.1);
+        tracers.push_back(&tracer);
+    }
+    std::vector<DGVector<DG>> separate = together;
+
+    for (int n = 0; n < 3; ++n) {
+        transport.step(2000., tracers);
+        for (auto& tracer : separate)
+            transport.step(2000., tracer);
+    }
+    for (size_t it = 0; it < nTracers; ++it)
+        CHECK(relativeDifference(together[it], separate[it]) < 1.e-14);
+}
+
+TEST_SUITE_BEGIN("DGTransport");
+TEST_CASE("Advection sub-steps from the Courant number")
+{
+    static const int DG = 3;
+
+    // 10 km square elements
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 10, 10);
+
+    DGTransport<DG> transport(smesh);
+    CGVector<1> vx(smesh), vy(smesh);
+    vx.setConstant(1.0);
+    vy.setConstant(0.5);
+    transport.prepareAdvection(vx, vy);
+
+    DGVector<DG> phi(smesh);
+    phi.setZero();
+
+    // 1 m s⁻¹ over 10 km in 10 000 s is a Courant number of 1
+    const double dt = 1.e4;
+    // No sub-stepping by default
+    transport.step(dt, phi);
+    CHECK(transport.GetCFL() == doctest::Approx(1.0));
+    CHECK(transport.GetSubsteps() == 1);
+
+    // The stability limit of the linear scheme is 1/3
+    transport.setCFLSafety(0.9);
+    transport.step(dt, phi);
+    CHECK(transport.GetCFL() == doctest::Approx(1.0));
+    CHECK(transport.GetSubsteps() == 4);
+
+    transport.setCFLSafety(0.5);
+    transport.step(dt, phi);
+    CHECK(transport.GetSubsteps() == 6);
+
+    // A short enough timestep needs no sub-steps
+    transport.step(dt / 10, phi);
+    CHECK(transport.GetCFL() == doctest::Approx(0.1));
+    CHECK(transport.GetSubsteps() == 1);
+}
+
+TEST_CASE("Matrix-free cell terms")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 7, 6, 0.2);
+
+    checkMatrixFree<1>(smesh, "rk1");
+    checkMatrixFree<3>(smesh, "rk2");
+    checkMatrixFree<6>(smesh, "rk3");
+}
+
+TEST_CASE("Several tracers in one step")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 7, 6, 0.2);
+    smesh.landmask[20] = false;
+
+    for (const std::string scheme : { "rk1", "rk2", "rk3" }) {
+        checkTracers<3>(smesh, scheme);
+        checkTracers<6>(smesh, scheme);
+    }
+}
+TEST_SUITE_END();
+
+}
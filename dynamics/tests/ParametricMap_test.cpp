@@ -0,0 +1,172 @@
+/*!
+ * @file ParametricMap_test.cpp
+ *
+ * @brief Test that the element matrices shared between equivalent elements
+ * equal those computed for each element on its own.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "include/Interpolations.hpp"
+#include "include/ParametricMap.hpp"
+#include "include/Tools.hpp"
+
+#include "TestMesh.hpp"
+
+#include <random>
+
+namespace Nextsim {
+
+// A mesh holding only the given element of another mesh
+void elementMesh(ParametricMesh& single, const ParametricMesh& smesh, size_t eid)
+{
+    makeTestMesh(single, 1, 1);
+    single.vertices = smesh.coordinatesOfElement(eid);
+}
+
+template <typename Matrix>
+double relativeDifference(const Matrix& a, const Matrix& b)
+{
+    return (a - b).norm() / b.norm();
+}
+
+/*
+ * Compares the matrices of every element of the mesh with those of a mesh
+ * made of that element alone, where no other element can share them.
+ */
+template <int DG, int CG>
+void checkElementMatrices(const ParametricMesh& smesh)
+{
+    const double tolerance = 1.e-12;
+
+    ParametricTransportMap<DG> tmap(smesh);
+    tmap.InitializeAdvectionCellTerms();
+    tmap.InitializeInverseDGMassMatrix();
+    tmap.InitializeL2Projection();
+    ParametricMomentumMap<CG> mmap(smesh);
+    mmap.InitializeDivSMatrices();
+    REQUIRE(tmap.classes);
+    REQUIRE(mmap.classes);
+
+    for (size_t eid = 0; eid < smesh.nelements; ++eid) {
+        ParametricMesh single(CARTESIAN);
+        elementMesh(single, smesh, eid);
+        ParametricTransportMap<DG> tsingle(single);
+        tsingle.InitializeAdvectionCellTerms();
+        tsingle.InitializeInverseDGMassMatrix();
+        tsingle.InitializeL2Projection();
+        ParametricMomentumMap<CG> msingle(single);
+        msingle.InitializeDivSMatrices();
+
+        CHECK(relativeDifference(tmap.AdvectionCellTermX[eid], tsingle.AdvectionCellTermX[0]) < tolerance);
+        CHECK(relativeDifference(tmap.AdvectionCellTermY[eid], tsingle.AdvectionCellTermY[0]) < tolerance);
+        CHECK(relativeDifference(tmap.InverseDGMassMatrix[eid], tsingle.InverseDGMassMatrix[0]) < tolerance);
+        CHECK(relativeDifference(tmap.L2Projection[eid], tsingle.L2Projection[0]) < tolerance);
+        CHECK(relativeDifference(mmap.divS1[eid], msingle.divS1[0]) < tolerance);
+        CHECK(relativeDifference(mmap.divS2[eid], msingle.divS2[0]) < tolerance);
+        CHECK(relativeDifference(mmap.iMgradX[eid], msingle.iMgradX[0]) < tolerance);
+        CHECK(relativeDifference(mmap.iMgradY[eid], msingle.iMgradY[0]) < tolerance);
+        CHECK(relativeDifference(mmap.iMJwPSI[eid], msingle.iMJwPSI[0]) < tolerance);
+    }
+}
+
+// Compares the projections with and without the L2 projection of the map
+template <int CG, int DG>
+void checkCachedProjection(const ParametricMesh& smesh)
+{
+    ParametricTransportMap<DG> map(smesh);
+    map.InitializeL2Projection();
+
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-1., 1.);
+    CGVector<CG> cg(smesh);
+    for (long i = 0; i < cg.rows(); ++i)
+        cg(i) = dist(gen);
+
+    DGVector<DG> uncached(smesh), cached(smesh);
+    Interpolations::CG2DG(smesh, uncached, cg);
+    Interpolations::CG2DG(smesh, cached, cg, map);
+    CHECK(relativeDifference(cached, uncached) < 1.e-12);
+}
+
+TEST_SUITE_BEGIN("ParametricMap");
+TEST_CASE("Uniform mesh")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 6, 5);
+
+    ElementClasses classes(smesh);
+    CHECK(classes.size() == 1);
+
+    checkElementMatrices<3, 1>(smesh);
+    checkElementMatrices<6, 2>(smesh);
+}
+
+TEST_CASE("Distorted mesh")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 6, 5, 0.2);
+
+    // Each element has a displaced vertex, so no two are equivalent
+    ElementClasses classes(smesh);
+    CHECK(classes.size() == smesh.nelements);
+
+    checkElementMatrices<3, 1>(smesh);
+    checkElementMatrices<6, 2>(smesh);
+}
+
+TEST_CASE("Nearly equal elements")
+{
+    const double dx = 1.e4;
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 4, 4, 0., dx);
+
+    // Elements are compared to 1e-10 of the mesh size. Moving a vertex by far
+    // less than that keeps the four elements around it in the single class.
+    const size_t vertex = 2 * (smesh.nx + 1) + 2;
+    smesh.vertices(vertex, 0) += 1.e-14 * dx;
+    smesh.vertices(vertex, 1) -= 1.e-14 * dx;
+    CHECK(ElementClasses(smesh).size() == 1);
+    checkElementMatrices<3, 1>(smesh);
+
+    // Moving it by more gives each of the four elements its own class
+    smesh.vertices(vertex, 0) += 1.e-6 * dx;
+    ElementClasses classes(smesh);
+    CHECK(classes.size() == 5);
+    for (size_t eid : { 5, 6, 9, 10 })
+        CHECK(classes.classOf[eid] != classes.classOf[0]);
+    checkElementMatrices<3, 1>(smesh);
+    checkElementMatrices<6, 2>(smesh);
+}
+
+TEST_CASE("Cached projections")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 7, 6, 0.2);
+    // Land elements are skipped by both
+    smesh.landmask[10] = false;
+
+    checkCachedProjection<1, 3>(smesh);
+    checkCachedProjection<2, 3>(smesh);
+    checkCachedProjection<2, 6>(smesh);
+
+    // The shear of the ice from the strain in the dG stress space
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(-1.e-6, 1.e-6);
+    DGVector<8> E11(smesh), E12(smesh), E22(smesh);
+    for (size_t i = 0; i < smesh.nelements; ++i)
+        for (int j = 0; j < 8; ++j) {
+            E11(i, j) = dist(gen);
+            E12(i, j) = dist(gen);
+            E22(i, j) = dist(gen);
+        }
+    ParametricTransportMap<6> map(smesh);
+    map.InitializeL2Projection();
+    CHECK(relativeDifference(Tools::Shear(smesh, E11, E12, E22, map),
+              Tools::Shear(smesh, E11, E12, E22))
+        < 1.e-12);
+}
+TEST_SUITE_END();
+
+}
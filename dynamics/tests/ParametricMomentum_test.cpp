@@ -0,0 +1,216 @@
+/*!
+ * @file ParametricMomentum_test.cpp
+ *
+ * @brief Test the mEVP iteration of the CG momentum solver.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "include/cgParametricMomentum.hpp"
+#include "include/mevp.hpp"
+
+#include "TestMesh.hpp"
+
+#include <random>
+
+namespace Nextsim {
+
+// Fills a vector with reproducible random values in [-scale, scale]
+template <typename Vector>
+void fillRandom(Vector& v, std::mt19937& gen, double scale)
+{
+    std::uniform_real_distribution<double> dist(-scale, scale);
+    for (long i = 0; i < v.rows(); ++i)
+        for (long j = 0; j < v.cols(); ++j)
+            v(i, j) = dist(gen);
+}
+
+template <typename Vector>
+double relativeDifference(const Vector& a, const Vector& b)
+{
+    return (a - b).norm() / b.norm();
+}
+
+/*
+ * Compares the strain and the divergence of the stress computed with stored
+ * element matrices and computed on the fly.
+ */
+template <int CG>
+void checkMatrixFree(const ParametricMesh& smesh)
+{
+    const double tolerance = 1.e-12;
+
+    CGParametricMomentum<CG> stored(smesh);
+    CGParametricMomentum<CG> matrixFree(smesh, true);
+
+    std::mt19937 gen(42);
+    fillRandom(stored.GetVx(), gen, 0.2);
+    fillRandom(stored.GetVy(), gen, 0.2);
+    fillRandom(stored.GetS11(), gen, 1.e4);
+    fillRandom(stored.GetS12(), gen, 1.e4);
+    fillRandom(stored.GetS22(), gen, 1.e4);
+    matrixFree.GetVx() = stored.GetVx();
+    matrixFree.GetVy() = stored.GetVy();
+    matrixFree.GetS11() = stored.GetS11();
+    matrixFree.GetS12() = stored.GetS12();
+    matrixFree.GetS22() = stored.GetS22();
+
+    stored.ProjectCGVelocityToDGStrain();
+    matrixFree.ProjectCGVelocityToDGStrain();
+    CHECK(relativeDifference(matrixFree.GetE11(), stored.GetE11()) < tolerance);
+    CHECK(relativeDifference(matrixFree.GetE12(), stored.GetE12()) < tolerance);
+    CHECK(relativeDifference(matrixFree.GetE22(), stored.GetE22()) < tolerance);
+
+    CGVector<CG> txStored(smesh), tyStored(smesh), txFree(smesh), tyFree(smesh);
+    stored.DivergenceOfStress(1.0, txStored, tyStored);
+    matrixFree.DivergenceOfStress(1.0, txFree, tyFree);
+    CHECK(relativeDifference(txFree, txStored) < tolerance);
+    CHECK(relativeDifference(tyFree, tyStored) < tolerance);
+}
+
+/*
+ * Compares the fused strain, stress update and divergence of the stress of
+ * one mEVP iteration with the three separate sweeps.
+ */
+template <int CG, int DG>
+void checkFusedStep(const ParametricMesh& smesh, bool matrixfree)
+{
+    const double alpha = 300.;
+    const double beta = 300.;
+
+    CGParametricMomentum<CG> fused(smesh, matrixfree);
+    CGParametricMomentum<CG> separate(smesh, matrixfree);
+
+    std::mt19937 gen(11);
+    fillRandom(fused.GetVx(), gen, 0.2);
+    fillRandom(fused.GetVy(), gen, 0.2);
+    fillRandom(fused.GetS11(), gen, 1.e4);
+    fillRandom(fused.GetS12(), gen, 1.e4);
+    fillRandom(fused.GetS22(), gen, 1.e4);
+    separate.GetVx() = fused.GetVx();
+    separate.GetVy() = fused.GetVy();
+    separate.GetS11() = fused.GetS11();
+    separate.GetS12() = fused.GetS12();
+    separate.GetS22() = fused.GetS22();
+    // The stress update of the land elements uses the strain left from earlier
+    fused.E11.setZero();
+    fused.E12.setZero();
+    fused.E22.setZero();
+    separate.E11.setZero();
+    separate.E12.setZero();
+    separate.E22.setZero();
+
+    DGVector<DG> H(smesh), A(smesh);
+    fillRandom(H, gen, 0.1);
+    fillRandom(A, gen, 0.1);
+    for (size_t i = 0; i < smesh.nelements; ++i) {
+        H(i, 0) += 1.0;
+        A(i, 0) += 0.8;
+    }
+    VPParameters vp;
+
+    CGVector<CG> txFused(smesh), tyFused(smesh), txSeparate(smesh), tySeparate(smesh);
+    fused.mEVPStressDivergence(vp, alpha, 1.0, H, A, txFused, tyFused);
+
+    separate.ProjectCGVelocityToDGStrain();
+    mEVP::StressUpdateHighOrder(vp, separate.pmap, smesh, separate.S11, separate.S12,
+        separate.S22, separate.E11, separate.E12, separate.E22, H, A, alpha, beta);
+    separate.DivergenceOfStress(1.0, txSeparate, tySeparate);
+
+    const double tolerance = 1.e-12;
+    CHECK(relativeDifference(fused.GetS11(), separate.GetS11()) < tolerance);
+    CHECK(relativeDifference(fused.GetS12(), separate.GetS12()) < tolerance);
+    CHECK(relativeDifference(fused.GetS22(), separate.GetS22()) < tolerance);
+    CHECK(relativeDifference(txFused, txSeparate) < tolerance);
+    CHECK(relativeDifference(tyFused, tySeparate) < tolerance);
+}
+
+TEST_SUITE_BEGIN("ParametricMomentum");
+TEST_CASE("mEVP stops early once converged")
+{
+    static const int CG = 2;
+    static const int DG = 3;
+    const size_t maxIterations = 500;
+    const double tolerance = 1.e-5;
+
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 8, 8, 0.1);
+    // One land element in the interior
+    const size_t landElement = 3 * smesh.nx + 3;
+    smesh.landmask[landElement] = false;
+
+    CGParametricMomentum<CG> momentum(smesh);
+    momentum.GetVx().setZero();
+    momentum.GetVy().setZero();
+    momentum.GetAtmx().setZero();
+    momentum.GetAtmy().setZero();
+    // A uniform ocean current, which the Dirichlet and land nodes never follow
+    momentum.GetOceanx().setConstant(0.1);
+    momentum.GetOceany().setConstant(-0.05);
+    momentum.E11.setZero();
+    momentum.E12.setZero();
+    momentum.E22.setZero();
+    momentum.GetS11().setZero();
+    momentum.GetS12().setZero();
+    momentum.GetS22().setZero();
+
+    DGVector<DG> H(smesh), A(smesh);
+    H.setZero();
+    A.setZero();
+    for (size_t i = 0; i < smesh.nelements; ++i) {
+        H(i, 0) = 1.0;
+        A(i, 0) = 0.9;
+    }
+
+    VPParameters vp;
+    momentum.prepareIteration(H, A);
+    size_t mevpstep = 0;
+    double change = 0.;
+    while (mevpstep < maxIterations) {
+        change = momentum.mEVPStep(vp, maxIterations, 300., 300., 120., H, A);
+        ++mevpstep;
+        if (change < tolerance)
+            break;
+    }
+
+    // The boundary and land nodes are reset in every iteration, so they must
+    // not keep the change above the tolerance.
+    CHECK(mevpstep < maxIterations);
+    CHECK(change < tolerance);
+    // Without a tolerance the change is not measured
+    CHECK(momentum.mEVPStep(vp, maxIterations, 300., 300., 120., H, A, false) == 0.);
+
+    const CGVector<CG>& vx = momentum.GetVx();
+    const size_t inrow = CG * smesh.nx + 1;
+    CHECK(vx(0) == 0.);
+    CHECK(vx(vx.rows() - 1) == 0.);
+    const size_t lx = landElement % smesh.nx;
+    const size_t ly = landElement / smesh.nx;
+    CHECK(vx(inrow * (CG * ly + 1) + CG * lx + 1) == 0.);
+    // The interior follows the ocean
+    CHECK(vx(inrow * CG + CG) > 0.);
+}
+
+TEST_CASE("Matrix-free strain and divergence of the stress")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 7, 6, 0.2);
+
+    checkMatrixFree<1>(smesh);
+    checkMatrixFree<2>(smesh);
+}
+
+TEST_CASE("Fused mEVP stress and divergence")
+{
+    ParametricMesh smesh(CARTESIAN);
+    makeTestMesh(smesh, 7, 6, 0.2);
+    smesh.landmask[16] = false;
+
+    checkFusedStep<1, 3>(smesh, false);
+    checkFusedStep<2, 6>(smesh, false);
+    checkFusedStep<2, 6>(smesh, true);
+}
+TEST_SUITE_END();
+
+}
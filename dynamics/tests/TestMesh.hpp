@@ -0,0 +1,52 @@
+/*!
+ * @file TestMesh.hpp
+ *
+ * @brief Small Cartesian meshes for the dynamics tests.
+ */
+
+#ifndef TESTMESH_HPP
+#define TESTMESH_HPP
+
+#include "include/ParametricMesh.hpp"
+
+#include <cmath>
+
+namespace Nextsim {
+
+/*!
+ * Fills smesh with nx * ny square elements of size dx, with Dirichlet
+ * boundaries on all four sides and no land. With a non-zero distortion, the
+ * interior nodes are displaced by up to distortion * dx, so that the elements
+ * are general quadrilaterals.
+ */
+inline void makeTestMesh(ParametricMesh& smesh, size_t nx, size_t ny, double distortion = 0.,
+    double dx = 1.e4)
+{
+    smesh.reset();
+    smesh.nx = nx;
+    smesh.ny = ny;
+    smesh.nelements = nx * ny;
+    smesh.nnodes = (nx + 1) * (ny + 1);
+    smesh.vertices.resize(smesh.nnodes, 2);
+    for (size_t iy = 0; iy <= ny; ++iy)
+        for (size_t ix = 0; ix <= nx; ++ix) {
+            const bool interior = (ix > 0) && (ix < nx) && (iy > 0) && (iy < ny);
+            const double shift = interior ? distortion * dx : 0.;
+            smesh.vertices(iy * (nx + 1) + ix, 0) = dx * ix + shift * std::sin(1.3 * ix + 2.1 * iy);
+            smesh.vertices(iy * (nx + 1) + ix, 1) = dx * iy + shift * std::cos(0.7 * ix + 1.9 * iy);
+        }
+
+    for (size_t i = 0; i < nx; ++i) {
+        smesh.dirichlet[0].push_back(i);
+        smesh.dirichlet[2].push_back(i + nx * (ny - 1));
+    }
+    for (size_t i = 0; i < ny; ++i) {
+        smesh.dirichlet[1].push_back(i * nx + nx - 1);
+        smesh.dirichlet[3].push_back(i * nx);
+    }
+    smesh.landmask.resize(smesh.nelements, true);
+}
+
+}
+
+#endif /* TESTMESH_HPP */
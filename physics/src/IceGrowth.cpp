@@ -10,6 +10,8 @@
 #include "include/Module.hpp"
 #include "include/constants.hpp"
 
+#include "include/StaticModule.hpp"
+
 namespace Nextsim {
 
 template <>
@@ -19,6 +21,7 @@ const std::map<int, std::string> Configured<IceGrowth>::keyMap = {
     { IceGrowth::MINC_KEY, "nextsim_thermo.min_conc" },
     { IceGrowth::MINH_KEY, "nextsim_thermo.min_thick" },
     { IceGrowth::USE_THERMO_KEY, "nextsim_thermo.use_thermo_forcing" },
+    { IceGrowth::ACTIVE_CELLS_KEY, "IceGrowth.activeCells" },
 };
 
 IceGrowth::IceGrowth()
@@ -63,6 +66,8 @@ void IceGrowth::setData(const ModelState::DataMap& ms)
     hice0.resize();
     hsnow0.resize();
     newice.resize();
+    // Only ocean elements are updated, so zero the land values here
+    newice = 0;
     snowMelt.resize();
     deltaCFreeze.resize();
     deltaCMelt.resize();
@@ -101,6 +106,9 @@ IceGrowth::HelpMap& IceGrowth::getHelpText(HelpMap& map, bool getAll)
             std::to_string(IceMinima::hMinDefault), "m", "Minimum allowed ice thickness." },
         { keyMap.at(USE_THERMO_KEY), ConfigType::BOOLEAN, { "true", "false" }, "true", "",
             "Perform ice physics calculations as part of the timestep." },
+        { keyMap.at(ACTIVE_CELLS_KEY), ConfigType::BOOLEAN, { "true", "false" }, "true", "",
+            "Only perform the full ice physics calculations on the elements where there is "
+            "ice or where new ice forms during the timestep." },
     };
     return map;
 }
@@ -116,6 +124,9 @@ void IceGrowth::configure()
 {
     // Configure whether we actually do anything here
     doThermo = Configured::getConfiguration(keyMap.at(USE_THERMO_KEY), true);
+    activeCells = Configured::getConfiguration(keyMap.at(ACTIVE_CELLS_KEY), true);
+    // Start with every ocean element active
+    resetActiveElements();
     // Configure constants
     IceMinima::cMin = Configured::getConfiguration(keyMap.at(MINC_KEY), IceMinima::cMinDefault);
     IceMinima::hMin = Configured::getConfiguration(keyMap.at(MINH_KEY), IceMinima::hMinDefault);
@@ -123,6 +134,8 @@ void IceGrowth::configure()
     // Configure the vertical and lateral growth modules
     iVertical = std::move(Module::getInstance<IIceThermodynamics>());
     iLateral = std::move(Module::getInstance<ILateralIceSpread>());
+    Module::checkStaticImplementation(*iVertical);
+    Module::checkStaticImplementation(*iLateral);
     tryConfigure(*iVertical);
     tryConfigure(*iLateral);
 }
@@ -137,23 +150,85 @@ ConfigMap IceGrowth::getConfiguration() const
 
 void IceGrowth::update(const TimestepTime& tsTime)
 {
-    // Copy the ice data from the prognostic fields to the modifiable fields.
-    initializeThicknesses();
+    if (doThermo && activeCells) {
+        // Divide the ocean elements into those with ice or new ice, and those
+        // with only open water. The lists are also used by the thermodynamics.
+        updateActiveElements([this, &tsTime](size_t i) { return isActiveElement(i, tsTime); });
+    }
 
-    if (doThermo) {
+    if (doThermo && !iVertical->hasElementUpdate()) {
+        // The vertical thermodynamics can only be applied to the whole grid,
+        // so the column calculations are split around it.
+        initializeThicknesses();
         iVertical->update(tsTime);
         // new ice formation
-        overElements(std::bind(&IceGrowth::updateWrapper, this, std::placeholders::_1,
-                         std::placeholders::_2),
-            tsTime);
+        parallelOverActiveElements(
+            [this](size_t i, const TimestepTime& t) { updateWrapper(i, t); }, tsTime);
+        parallelOverInactiveElements(
+            [this](size_t i, const TimestepTime&) { iceFreeWrapper(i); }, tsTime);
+        return;
+    }
+
+    cice = cice0;
+    // Initialize the thicknesses, then do the vertical and lateral growth,
+    // all in a single pass over the columns.
+    parallelOverActiveElements(
+        [this](size_t i, const TimestepTime& t) { updateColumn(i, t); }, tsTime);
+    parallelOverInactiveElements(
+        [this](size_t i, const TimestepTime& t) { updateIceFreeColumn(i, t); }, tsTime);
+}
+
+/*
+ * An element is active if it has ice, or if the open water cooling takes the
+ * mixed layer below the freezing point, which is the same test as in
+ * newIceFormation().
+ */
+bool IceGrowth::isActiveElement(size_t i, const TimestepTime& tst) const
+{
+    if (cice0[i] > 0 && hIceCell[i] > 0)
+        return true;
+    double deltaTml = -qow[i] / mixedLayerBulkHeatCapacity[i] * tst.step;
+    return sst[i] + deltaTml < tf[i];
+}
+
+void IceGrowth::updateIceFreeColumn(size_t i, const TimestepTime& tst)
+{
+    initializeThicknessesElement(i, tst);
+    // The thermodynamics resets its own fields in an element with no ice
+    Module::asStaticImplementation(*iVertical).updateElement(i, tst);
+    iceFreeWrapper(i);
+}
+
+/*
+ * With no ice and no new ice there is no lateral growth or melt, and the
+ * limits have no ice to remove, so only the computed arrays need to be reset.
+ * The open water flux is unchanged.
+ */
+void IceGrowth::iceFreeWrapper(size_t i)
+{
+    newice[i] = 0;
+    deltaCFreeze[i] = 0;
+    deltaCMelt[i] = 0;
+    deltaCIce[i] = 0;
+    cice[i] = 0;
+}
+
+void IceGrowth::updateColumn(size_t i, const TimestepTime& tst)
+{
+    // Copy the ice data from the prognostic fields to the modifiable fields.
+    initializeThicknessesElement(i, tst);
+
+    if (doThermo) {
+        Module::asStaticImplementation(*iVertical).updateElement(i, tst);
+        updateWrapper(i, tst);
     }
 }
 
 void IceGrowth::initializeThicknesses()
 {
     cice = cice0;
-    overElements(std::bind(&IceGrowth::initializeThicknessesElement, this, std::placeholders::_1,
-                     std::placeholders::_2),
+    parallelOverElements(
+        [this](size_t i, const TimestepTime& t) { initializeThicknessesElement(i, t); },
         TimestepTime());
 }
 
@@ -162,6 +237,8 @@ void IceGrowth::initializeThicknesses()
 void IceGrowth::initializeThicknessesElement(size_t i, const TimestepTime&)
 {
     deltaCIce[i] = 0;
+    // reset the new ice volume
+    newice[i] = 0;
 
     if (cice0[i] > 0 && hIceCell[i] > 0) {
         hice[i] = hice0[i] = hIceCell[i] / cice0[i];
@@ -170,9 +247,6 @@ void IceGrowth::initializeThicknessesElement(size_t i, const TimestepTime&)
         hice[i] = hice0[i] = 0.;
         hsnow[i] = hsnow0[i] = 0.;
     }
-
-    // reset the new ice volume array
-    newice = 0;
 }
 
 void IceGrowth::newIceFormation(size_t i, const TimestepTime& tst)
@@ -211,36 +285,61 @@ static double updateThickness(double& thick, double newConc, double deltaC, doub
 
 void IceGrowth::lateralIceSpread(size_t i, const TimestepTime& tstep)
 {
-    deltaCMelt[i] = 0;
-    deltaCFreeze[i] = 0;
-    iLateral->freeze(
-        tstep, hice[i], hsnow[i], deltaHi[i], newice[i], cice[i], qow[i], deltaCFreeze[i]);
-    if (deltaHi[i] < 0) {
+    /*
+     * Take the data pointers once. Indexing the fields directly would look
+     * up the arrays again after each call to the lateral spread
+     * implementation, which may modify any memory.
+     */
+    double* NEXTSIM_RESTRICT hiceData = hice.getData();
+    double* NEXTSIM_RESTRICT hsnowData = hsnow.getData();
+    double* NEXTSIM_RESTRICT ciceData = cice.getData();
+    double* NEXTSIM_RESTRICT qowData = qow.getData();
+    double* NEXTSIM_RESTRICT deltaCIceData = deltaCIce.getData();
+    double* NEXTSIM_RESTRICT deltaCFreezeData = deltaCFreeze.getData();
+    double* NEXTSIM_RESTRICT deltaCMeltData = deltaCMelt.getData();
+    const double* NEXTSIM_RESTRICT newiceData = newice.getData();
+    const double* NEXTSIM_RESTRICT hice0Data = hice0.getData();
+    const double deltaHiValue = deltaHi[i];
+
+    deltaCMeltData[i] = 0;
+    deltaCFreezeData[i] = 0;
+    auto& lateral = Module::asStaticImplementation(*iLateral);
+    lateral.freeze(tstep, hiceData[i], hsnowData[i], deltaHiValue, newiceData[i], ciceData[i],
+        qowData[i], deltaCFreezeData[i]);
+    if (deltaHiValue < 0) {
         // Note that the cell-averaged hice0 is converted to a ice averaged value
-        iLateral->melt(tstep, hice0[i], hsnow[i], deltaHi[i], cice[i], qow[i], deltaCMelt[i]);
+        lateral.melt(tstep, hice0Data[i], hsnowData[i], deltaHiValue, ciceData[i], qowData[i],
+            deltaCMeltData[i]);
     }
-    deltaCIce[i] = deltaCFreeze[i] + deltaCMelt[i];
-    cice[i] = (hice[i] > 0) ? cice[i] + deltaCIce[i] : 0;
-    if (cice[i] >= IceMinima::c()) {
+    const double deltaC = deltaCFreezeData[i] + deltaCMeltData[i];
+    deltaCIceData[i] = deltaC;
+    double& c = ciceData[i];
+    c = (hiceData[i] > 0) ? c + deltaC : 0;
+    if (c >= IceMinima::c()) {
         // The updated ice thickness must conserve volume
-        updateThickness(hice[i], cice[i], deltaCIce[i], newice[i]);
-        if (deltaCIce[i] < 0) {
+        updateThickness(hiceData[i], c, deltaC, newiceData[i]);
+        if (deltaC < 0) {
             // Snow is lost if the concentration decreases, and energy is returned to the ocean
-            qow[i] -= deltaCIce[i] * hsnow[i] * Water::Lf * Ice::rhoSnow / tstep.step;
+            qowData[i] -= deltaC * hsnowData[i] * Water::Lf * Ice::rhoSnow / tstep.step;
         } else {
             // Update snow thickness. Currently no new snow is implemented
-            updateThickness(hsnow[i], cice[i], deltaCIce[i], 0);
+            updateThickness(hsnowData[i], c, deltaC, 0);
         }
     }
 }
 
 void IceGrowth::applyLimits(size_t i, const TimestepTime& tstep)
 {
-    if ((0. < cice[i] && cice[i] < IceMinima::c()) || (0. < hice[i] && hice[i] < IceMinima::h())) {
-        qow[i] += cice[i] * Water::Lf * (hice[i] * Ice::rho + hsnow[i] * Ice::rhoSnow) / tstep.step;
-        hice[i] = 0;
-        cice[i] = 0;
-        hsnow[i] = 0;
+    double* NEXTSIM_RESTRICT hiceData = hice.getData();
+    double* NEXTSIM_RESTRICT hsnowData = hsnow.getData();
+    double* NEXTSIM_RESTRICT ciceData = cice.getData();
+    const double c = ciceData[i];
+    const double h = hiceData[i];
+    if ((0. < c && c < IceMinima::c()) || (0. < h && h < IceMinima::h())) {
+        qow[i] += c * Water::Lf * (h * Ice::rho + hsnowData[i] * Ice::rhoSnow) / tstep.step;
+        hiceData[i] = 0;
+        ciceData[i] = 0;
+        hsnowData[i] = 0;
     }
 }
 } /* namespace Nextsim */
@@ -74,29 +74,35 @@ std::unordered_set<std::string> SlabOcean::hFields() const { return { sstSlabNam
 
 void SlabOcean::update(const TimestepTime& tst)
 {
+    /*
+     * The ModelArray arithmetic here builds lazy expressions, so each
+     * assignment to a field below is evaluated in a single pass over the
+     * grid, without intermediate arrays. The named expressions are
+     * recalculated wherever they are used, which costs arithmetic rather than
+     * memory traffic.
+     */
     double dt = tst.step.seconds();
     // Slab SST update
     qdw = (sstExt - sst) * cpml / relaxationTimeT;
-    HField qioMean = qio * cice; // cice at start of TS, not updated
-    HField qowMean = qow * (1 - cice); // 1- cice = open water fraction
+    auto qioMean = qio * cice; // cice at start of TS, not updated
+    auto qowMean = qow * (1 - cice); // 1- cice = open water fraction
     sstSlab = sst - dt * (qioMean + qowMean - qdw) / cpml;
     // Slab SSS update
-    HField arealDensity = cpml / Water::cp; // density times depth, or cpml divided by cp
+    auto arealDensity = cpml / Water::cp; // density times depth, or cpml divided by cp
     // This is simplified compared to the finiteelement.cpp calculation
     // Fdw = delS * mld * physical::rhow /(timeS*M_sss[i] - ddt*delS) where delS = sssSlab - sssExt
     fdw = (1 - sssExt / sss) * arealDensity / relaxationTimeS;
     // ice volume change, both laterally and vertically
-    HField deltaIceVol = newIce + deltaHice * cice;
+    auto deltaIceVol = newIce + deltaHice * cice;
     // change in snow volume due to melting (should be < 0)
-    HField meltSnowVol = deltaSmelt * cice;
-    // Mass per unit area after all the changes in water volume
-    HField denominator
-        = arealDensity - deltaIceVol * Ice::rho - meltSnowVol * Ice::rhoSnow - (emp - fdw) * dt;
-    // Clamp the denominator to be at least 1 m deep, i.e. at least Water::rho kg m⁻²
-    denominator.clampAbove(Water::rho);
+    auto meltSnowVol = deltaSmelt * cice;
+    // Mass per unit area after all the changes in water volume. Clamp the
+    // denominator to be at least 1 m deep, i.e. at least Water::rho kg m⁻²
+    auto denominator
+        = (arealDensity - deltaIceVol * Ice::rho - meltSnowVol * Ice::rhoSnow - (emp - fdw) * dt)
+              .max(Water::rho);
     // Effective ice salinity is always less than or equal to the SSS
-    HField effectiveIceSal = sss;
-    effectiveIceSal.clampBelow(Ice::s);
+    auto effectiveIceSal = sss.data().min(Ice::s);
     sssSlab = sss
         + ((sss - effectiveIceSal) * Ice::rho * deltaIceVol // Change due to ice changes
               + sss * meltSnowVol
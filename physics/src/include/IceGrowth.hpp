@@ -28,6 +28,7 @@ public:
         MINC_KEY,
         MINH_KEY,
         USE_THERMO_KEY,
+        ACTIVE_CELLS_KEY,
     };
 
     void configure() override;
@@ -99,6 +100,7 @@ private:
         deltaHi; // New ice thickness this timestep, m
 
     bool doThermo = true; // Perform any thermodynamics calculations at all
+    bool activeCells = true; // Only do the full calculation where there is or will be ice
 
     void newIceFormation(size_t i, const TimestepTime&);
     void lateralIceSpread(size_t i, const TimestepTime&);
@@ -110,6 +112,14 @@ private:
         applyLimits(i, tst);
     }
     void initializeThicknessesElement(size_t i, const TimestepTime&);
+    // The complete ice growth calculation for a single column
+    void updateColumn(size_t i, const TimestepTime& tst);
+    // Whether a column has ice or will form new ice during this timestep
+    bool isActiveElement(size_t i, const TimestepTime& tst) const;
+    // The ice growth calculation for a column with no ice and no new ice
+    void updateIceFreeColumn(size_t i, const TimestepTime& tst);
+    // The lateral growth and limits for a column with no ice and no new ice
+    void iceFreeWrapper(size_t i);
 };
 
 } /* namespace Nextsim */
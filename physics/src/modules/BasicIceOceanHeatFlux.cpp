@@ -17,9 +17,7 @@ static inline double doOne(double tBot, double sst, double mlBulkCp, double time
 
 void BasicIceOceanHeatFlux::update(const TimestepTime& tst)
 {
-    overElements(std::bind(&BasicIceOceanHeatFlux::updateElement, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        tst);
+    parallelOverElements([this](size_t i, const TimestepTime& t) { updateElement(i, t); }, tst);
 }
 
 void BasicIceOceanHeatFlux::updateElement(size_t i, const TimestepTime& tst)
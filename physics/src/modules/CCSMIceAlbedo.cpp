@@ -7,6 +7,7 @@
 
 #include "include/CCSMIceAlbedo.hpp"
 
+#include <Eigen/Core>
 #include <cmath>
 
 /* Albedo scheme from ccsm 3 */
@@ -43,6 +44,24 @@ std::tuple<double, double> CCSMIceAlbedo::albedo(
     return {albedo, penSW};
 }
 
+void CCSMIceAlbedo::albedo(size_t n, const double* temperature, const double* snowThickness,
+    double i0, double* albedoOut, double* penSWOut)
+{
+    // Eigen array expressions, as GCC does not if-convert the temperature
+    // clamping in the equivalent scalar loop
+    using ConstMap = Eigen::Map<const Eigen::ArrayXd>;
+    using Map = Eigen::Map<Eigen::ArrayXd>;
+    const double tLimit = -1.;
+    ConstMap tSurf(temperature, n);
+    ConstMap hSnow(snowThickness, n);
+    const auto dT = (tSurf - tLimit).max(0.);
+    const auto snowCoverFraction = hSnow / (hSnow + 0.02);
+
+    Map(albedoOut, n) = snowCoverFraction * (snowAlbedo - 0.124 * dT)
+        + (1 - snowCoverFraction) * (iceAlbedo - 0.075 * dT);
+    Map(penSWOut, n) = (1. - snowCoverFraction) * i0;
+}
+
 void CCSMIceAlbedo::configure()
 {
     iceAlbedo = Configured::getConfiguration(iceAlbedoKey, ICE_ALBEDO0);
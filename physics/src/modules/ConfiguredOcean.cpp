@@ -91,7 +91,7 @@ void ConfiguredOcean::setData(const ModelState::DataMap& ms)
     mld = mld0;
     u = u0;
     v = v0;
-    tf = Module::getImplementation<IFreezingPoint>()(sssExt[0]);
+    Module::getImplementation<IFreezingPoint>()(sssExt, tf);
     cpml = Water::rho * Water::cp * mld[0];
 
     slabOcean.setData(ms);
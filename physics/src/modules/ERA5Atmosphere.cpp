@@ -8,7 +8,7 @@
 #include "include/ERA5Atmosphere.hpp"
 
 #include "include/Module.hpp"
-#include "include/ParaGridIO.hpp"
+#include "include/ParaGridForcing.hpp"
 
 namespace Nextsim {
 
@@ -16,14 +16,20 @@ std::string ERA5Atmosphere::filePath;
 
 static const std::string pfx = "ERA5Atmosphere";
 static const std::string fileKey = pfx + ".file";
+static const std::string prefetchKey = pfx + ".prefetch";
+static const std::string interpolateKey = pfx + ".interpolate";
 
 template <>
 const std::map<int, std::string> Configured<ERA5Atmosphere>::keyMap = {
     { ERA5Atmosphere::FILEPATH_KEY, fileKey },
+    { ERA5Atmosphere::PREFETCH_KEY, prefetchKey },
+    { ERA5Atmosphere::INTERPOLATE_KEY, interpolateKey },
 };
 
 ERA5Atmosphere::ERA5Atmosphere()
-    : fluxImpl(0)
+    : prefetch(false)
+    , interpolate(false)
+    , fluxImpl(0)
 {
     registerProtectedArray(ProtectedArray::T_AIR, &tair);
     registerProtectedArray(ProtectedArray::DEW_2M, &tdew);
@@ -33,11 +39,17 @@ ERA5Atmosphere::ERA5Atmosphere()
     registerProtectedArray(ProtectedArray::WIND_SPEED, &wind);
 }
 
+ERA5Atmosphere::~ERA5Atmosphere() = default;
+
 ConfigurationHelp::HelpMap& ERA5Atmosphere::getHelpRecursive(HelpMap& map, bool getAll)
 {
     map[pfx] = {
         { fileKey, ConfigType::STRING, {}, "", "",
             "Path to the processed NetCDF file providing the ERA5 forcings." },
+        { prefetchKey, ConfigType::BOOLEAN, { "true", "false" }, "false", "",
+            "Read the next forcing record in the background while the current one is in use." },
+        { interpolateKey, ConfigType::BOOLEAN, { "true", "false" }, "false", "",
+            "Linearly interpolate the forcings in time between the bracketing records." },
     };
     Module::getHelpRecursive<IFluxCalculation>(map, getAll);
 
@@ -47,34 +59,71 @@ ConfigurationHelp::HelpMap& ERA5Atmosphere::getHelpRecursive(HelpMap& map, bool
 void ERA5Atmosphere::configure()
 {
     filePath = Configured::getConfiguration(keyMap.at(FILEPATH_KEY), std::string());
+    prefetch = Configured::getConfiguration(keyMap.at(PREFETCH_KEY), false);
+    interpolate = Configured::getConfiguration(keyMap.at(INTERPOLATE_KEY), false);
+    forcingFile.reset();
 
     fluxImpl = &Module::getImplementation<IFluxCalculation>();
     tryConfigure(fluxImpl);
 }
 
-void ERA5Atmosphere::update(const TimestepTime& tst)
+void ERA5Atmosphere::updateForcing(const TimestepTime& tst)
 {
-    // TODO: Get more authoritative names for the forcings
-    std::set<std::string> forcings = { "tair", "dew2m", "pair", "sw_in", "lw_in", "wind_speed", "u", "v" };
-
-    ModelState state = ParaGridIO::readForcingTimeStatic(forcings, tst.start, filePath);
-    tair = state.data.at("tair");
-    tdew = state.data.at("dew2m");
-    pair = state.data.at("pair");
-    sw_in = state.data.at("sw_in");
-    lw_in = state.data.at("lw_in");
-    wind = state.data.at("wind_speed");
-    uwind = state.data.at("u");
-    vwind = state.data.at("v");
+    if (!forcingFile) {
+        // TODO: Get more authoritative names for the forcings
+        std::set<std::string> forcings
+            = { "tair", "dew2m", "pair", "sw_in", "lw_in", "wind_speed", "u", "v" };
+        forcingFile = std::make_unique<ParaGridForcing>(forcings, filePath);
+        forcingFile->setPrefetch(prefetch);
+        forcingFile->setInterpolate(interpolate);
+        // The forcing fields are written straight into the module arrays
+        forcingFile->bind("tair", tair);
+        forcingFile->bind("dew2m", tdew);
+        forcingFile->bind("pair", pair);
+        forcingFile->bind("sw_in", sw_in);
+        forcingFile->bind("lw_in", lw_in);
+        forcingFile->bind("wind_speed", wind);
+        forcingFile->bind("u", uwind);
+        forcingFile->bind("v", vwind);
+    }
+
+    // The forcing fields only change when a new record is read, or the
+    // interpolation between records moves on
+    forcingFile->update(tst.start);
+}
 
+void ERA5Atmosphere::update(const TimestepTime& tst)
+{
+    // Does nothing if the forcing has already been read for this timestep
+    updateForcing(tst);
     fluxImpl->update(tst);
 }
 
-void ERA5Atmosphere::setFilePath(const std::string& filePathIn) { filePath = filePathIn; }
+void ERA5Atmosphere::setFilePath(const std::string& filePathIn)
+{
+    filePath = filePathIn;
+    forcingFile.reset();
+}
+
+void ERA5Atmosphere::setPrefetch(bool doPrefetch)
+{
+    prefetch = doPrefetch;
+    if (forcingFile)
+        forcingFile->setPrefetch(prefetch);
+}
+
+void ERA5Atmosphere::setInterpolate(bool doInterpolate)
+{
+    interpolate = doInterpolate;
+    if (forcingFile)
+        forcingFile->setInterpolate(interpolate);
+}
 
 void ERA5Atmosphere::setData(const ModelState::DataMap& ms)
 {
     IAtmosphereBoundary::setData(ms);
+    // Any held forcing record must be read again into the new arrays
+    forcingFile.reset();
     fluxImpl->setData(ms);
 }
 
@@ -36,6 +36,7 @@ const std::map<int, std::string> Configured<FiniteElementFluxes>::keyMap = {
     { FiniteElementFluxes::DRAGICET_KEY, "nextsim_thermo.drag_ice_t" },
     { FiniteElementFluxes::OCEANALBEDO_KEY, "nextsim_thermo.albedoW" },
     { FiniteElementFluxes::I0_KEY, "nextsim_thermo.I_0" },
+    { FiniteElementFluxes::FUSED_KEY, "FiniteElementFluxes.fused" },
 };
 
 void FiniteElementFluxes::configure()
@@ -48,6 +49,7 @@ void FiniteElementFluxes::configure()
     dragIce_t = Configured::getConfiguration(keyMap.at(DRAGICET_KEY), dragIce_t_default);
     m_oceanAlbedo = Configured::getConfiguration(keyMap.at(OCEANALBEDO_KEY), oceanAlbedo_default);
     m_I0 = Configured::getConfiguration(keyMap.at(I0_KEY), i0_default);
+    fused = Configured::getConfiguration(keyMap.at(FUSED_KEY), true);
 }
 
 void FiniteElementFluxes::setData(const ModelState::DataMap& ms)
@@ -68,6 +70,9 @@ void FiniteElementFluxes::setData(const ModelState::DataMap& ms)
     sh_water.resize();
     sh_ice.resize();
     dshice_dT.resize();
+    tice_top.resize();
+    alb_ice.resize();
+    i0_ice.resize();
 }
 
 ModelState FiniteElementFluxes::getState() const { return { {}, {} }; }
@@ -95,6 +100,9 @@ FiniteElementFluxes::HelpMap& FiniteElementFluxes::getHelpText(HelpMap& map, boo
             std::to_string(oceanAlbedo_default), "", "Shortwave albedo of open ocean water." },
         { keyMap.at(I0_KEY), ConfigType::NUMERIC, { "0", "∞" }, std::to_string(i0_default), "",
             "Transmissivity of ice." },
+        { keyMap.at(FUSED_KEY), ConfigType::BOOLEAN, { "true", "false" }, "true", "",
+            "Calculate the atmospheric, open water and ice fluxes in a single pass over the "
+            "elements." },
     };
     return map;
 }
@@ -142,9 +150,8 @@ void FiniteElementFluxes::calculateIce(size_t i, const TimestepTime& tst)
         = dragIce_t * rho_air[i] * cp_air[i] * v_air[i] * (tice.zIndexAndLayer(i, 0) - t_air[i]);
     double dQsh_dT = dragIce_t * rho_air[i] * cp_air[i] * v_air[i];
     // Shortwave flux
-    double albedoValue, i0;
-    std::tie(albedoValue, i0)
-        = iIceAlbedoImpl->albedo(tice.zIndexAndLayer(i, 0), h_snow_true[i], m_I0);
+    const double albedoValue = alb_ice[i];
+    const double i0 = i0_ice[i];
     Q_sw_ia[i] = -sw_in[i] * (1. - albedoValue) * (1. - i0);
     penSW[i] = sw_in[i] * (1. - albedoValue) * i0;
     // Longwave flux
@@ -159,6 +166,15 @@ void FiniteElementFluxes::calculateIce(size_t i, const TimestepTime& tst)
 
 void FiniteElementFluxes::update(const TimestepTime& tst)
 {
+    if (fused) {
+        // The albedo is calculated from the surface ice temperature, which
+        // updateSpecificHumidity() extracts into tice_top, so must follow it
+        updateSpecificHumidity();
+        updateAlbedo(tst);
+        parallelOverElements(
+            [this](size_t i, const TimestepTime& t) { calculateElement(i, t); }, tst);
+        return;
+    }
     updateAtmosphere(tst); // common atmospheric values
     updateOW(tst); // qow
     updateIce(tst); // qia & dqia/dT
@@ -166,38 +182,44 @@ void FiniteElementFluxes::update(const TimestepTime& tst)
 
 void FiniteElementFluxes::updateAtmosphere(const TimestepTime& tst)
 {
-    overElements(std::bind(&FiniteElementFluxes::calculateAtmos, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        tst);
+    updateSpecificHumidity();
+    parallelOverElements([this](size_t i, const TimestepTime& t) { calculateAtmos(i, t); }, tst);
 }
 
 void FiniteElementFluxes::updateOW(const TimestepTime& tst)
 {
-    overElements(std::bind(&FiniteElementFluxes::calculateOW, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        tst);
+    parallelOverElements([this](size_t i, const TimestepTime& t) { calculateOW(i, t); }, tst);
 }
 
 void FiniteElementFluxes::updateIce(const TimestepTime& tst)
+{
+    updateAlbedo(tst);
+    parallelOverElements([this](size_t i, const TimestepTime& t) { calculateIce(i, t); }, tst);
+}
+
+void FiniteElementFluxes::updateAlbedo(const TimestepTime& tst)
 {
     iIceAlbedoImpl->setTime(tst.start);
-    overElements(std::bind(&FiniteElementFluxes::calculateIce, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        tst);
+    iIceAlbedoImpl->albedo(tice_top, h_snow_true, m_I0, alb_ice, i0_ice);
 }
 
-void FiniteElementFluxes::calculateAtmos(size_t i, const TimestepTime& tst)
+void FiniteElementFluxes::updateSpecificHumidity()
 {
+    const ModelArray& ticeArray = tice;
+    for (size_t i = 0; i < tice_top.size(); ++i) {
+        tice_top[i] = ticeArray.zIndexAndLayer(i, 0);
+    }
     // Specific humidity of...
     // ...the air
-    sh_air[i] = FiniteElementSpecHum::water()(t_dew2[i], p_air[i]);
+    FiniteElementSpecHum::water().evaluate(t_dew2, p_air, sh_air);
     // ...over the open ocean
-    sh_water[i] = FiniteElementSpecHum::water()(sst[i], p_air[i], sss[i]);
+    FiniteElementSpecHum::water().evaluate(sst, p_air, sss, sh_water);
     // ...over the ice
-    std::pair<double, double> iceData
-        = FiniteElementSpecHum::ice().valueAndDerivative(tice.zIndexAndLayer(i, 0), p_air[i]);
-    sh_ice[i] = iceData.first;
-    dshice_dT[i] = iceData.second;
+    FiniteElementSpecHum::ice().valueAndDerivative(tice_top, p_air, sh_ice, dshice_dT);
+}
+
+void FiniteElementFluxes::calculateAtmos(size_t i, const TimestepTime& tst)
+{
     // Density of the wet air
     double Ra_wet = Air::Ra / (1 - sh_air[i] * (1 - Vapour::Ra / Air::Ra));
     rho_air[i] = p_air[i] / (Ra_wet * kelvin(t_air[i]));
@@ -205,6 +227,67 @@ void FiniteElementFluxes::calculateAtmos(size_t i, const TimestepTime& tst)
     cp_air[i] = Air::cp + sh_air[i] * Vapour::cp;
 }
 
+void FiniteElementFluxes::calculateElement(size_t i, const TimestepTime&)
+{
+    /*
+     * The same calculations as calculateAtmos(), calculateOW() and
+     * calculateIce(), but with the intermediate values used from registers
+     * rather than read back from the arrays. The air properties and the
+     * diagnostic flux components are still stored. The specific humidities and
+     * the albedos are calculated beforehand for the whole grid by
+     * updateSpecificHumidity() and updateAlbedo().
+     */
+    const double tIce = tice_top[i];
+    const double pAir = p_air[i];
+    const double vAir = v_air[i];
+    const double tAir = t_air[i];
+    const double tSea = sst[i];
+    const double swIn = sw_in[i];
+    const double lwIn = lw_in[i];
+    const double shAir = sh_air[i];
+
+    // Density and heat capacity of the wet air
+    const double Ra_wet = Air::Ra / (1 - shAir * (1 - Vapour::Ra / Air::Ra));
+    const double rhoAir = pAir / (Ra_wet * kelvin(tAir));
+    const double cpAir = Air::cp + shAir * Vapour::cp;
+    rho_air[i] = rhoAir;
+    cp_air[i] = cpAir;
+
+    // Open water
+    evap[i] = dragOcean_q * rhoAir * vAir * (sh_water[i] - shAir);
+    const double qlhOW = evap[i] * latentHeatWater(tSea);
+    const double qshOW = dragOcean_t * rhoAir * cpAir * vAir * (tSea - tAir);
+    const double qswOW = -swIn * (1 - m_oceanAlbedo);
+    const double qlwOW = stefanBoltzmannLaw(tSea) - lwIn;
+    qow[i] = qlhOW + qshOW + qswOW + qlwOW;
+    Q_lh_ow[i] = qlhOW;
+    Q_sh_ow[i] = qshOW;
+    Q_sw_ow[i] = qswOW;
+    Q_lw_ow[i] = qlwOW;
+
+    // Ice
+    subl[i] = dragIce_t * rhoAir * vAir * (sh_ice[i] - shAir);
+    const double lIce = latentHeatIce(tIce);
+    const double qlhIA = subl[i] * lIce;
+    const double dmdot_dT = dragIce_t * rhoAir * vAir * dshice_dT[i];
+    const double dQlh_dT = lIce * dmdot_dT;
+    const double qshIA = dragIce_t * rhoAir * cpAir * vAir * (tIce - tAir);
+    const double dQsh_dT = dragIce_t * rhoAir * cpAir * vAir;
+    const double albedoValue = alb_ice[i];
+    const double i0 = i0_ice[i];
+    const double qswIA = -swIn * (1. - albedoValue) * (1. - i0);
+    penSW[i] = swIn * (1. - albedoValue) * i0;
+    const double sbIce = stefanBoltzmannLaw(tIce);
+    const double qlwIA = sbIce - lwIn;
+    const double dQlw_dT = 4 / kelvin(tIce) * sbIce;
+    qia[i] = qlhIA + qshIA + qswIA + qlwIA;
+    dqia_dt[i] = dQlh_dT + dQsh_dT + dQlw_dT;
+    Q_lh_ia[i] = qlhIA;
+    Q_sh_ia[i] = qshIA;
+    Q_sw_ia[i] = qswIA;
+    Q_lw_ia[i] = qlwIA;
+}
+
 double FiniteElementFluxes::latentHeatWater(double temperature)
 {
     // Polynomial approximation expressed using Horner's scheme
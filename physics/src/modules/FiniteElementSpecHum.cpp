@@ -7,10 +7,92 @@
 
 #include "include/FiniteElementSpecHum.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace Nextsim {
 
+namespace {
+// The number of values processed together by the array calculations
+const size_t blockSize = 256;
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+/*
+ * Exponential of a vector of values, by Cody & Waite range reduction and a
+ * polynomial. exp(x) = 2ⁿ exp(r), with n = round(x / ln 2) and |r| ≤ ln 2 / 2.
+ * The Taylor series for exp(r) to order 13 is accurate to within a couple of
+ * ulp of std::exp over that range.
+ */
+const double expMax = 709.;
+const double expMin = -708.;
+const double log2e = 1.4426950408889634;
+const double ln2Hi = 6.93145751953125e-1;
+const double ln2Lo = 1.42860682030941723212e-6;
+const double expCoeffs[] = { 1. / 6227020800., 1. / 479001600., 1. / 39916800., 1. / 3628800.,
+    1. / 362880., 1. / 40320., 1. / 5040., 1. / 720., 1. / 120., 1. / 24., 1. / 6., 1. / 2., 1.,
+    1. };
+#endif
+
+#if defined(__AVX512F__)
+const size_t expWidth = 8;
+inline void expVector(const double* x, double* y)
+{
+    __m512d v = _mm512_min_pd(_mm512_max_pd(_mm512_loadu_pd(x), _mm512_set1_pd(expMin)),
+        _mm512_set1_pd(expMax));
+    __m512d n = _mm512_roundscale_pd(
+        _mm512_mul_pd(v, _mm512_set1_pd(log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(ln2Hi), v);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(ln2Lo), r);
+    __m512d p = _mm512_set1_pd(expCoeffs[0]);
+    for (size_t c = 1; c < sizeof(expCoeffs) / sizeof(double); ++c) {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(expCoeffs[c]));
+    }
+    _mm512_storeu_pd(y, _mm512_scalef_pd(p, n));
+}
+#elif defined(__AVX2__) && defined(__FMA__)
+const size_t expWidth = 4;
+inline void expVector(const double* x, double* y)
+{
+    __m256d v = _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(x), _mm256_set1_pd(expMin)),
+        _mm256_set1_pd(expMax));
+    __m256d n = _mm256_round_pd(
+        _mm256_mul_pd(v, _mm256_set1_pd(log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(ln2Hi), v);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(ln2Lo), r);
+    __m256d p = _mm256_set1_pd(expCoeffs[0]);
+    for (size_t c = 1; c < sizeof(expCoeffs) / sizeof(double); ++c) {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(expCoeffs[c]));
+    }
+    // Build 2ⁿ directly from the exponent bits. The clamping keeps n + 1023
+    // within the normal range.
+    __m256i bits = _mm256_slli_epi64(
+        _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), _mm256_set1_epi64x(1023)),
+        52);
+    _mm256_storeu_pd(y, _mm256_mul_pd(p, _mm256_castsi256_pd(bits)));
+}
+#else
+const size_t expWidth = 1;
+inline void expVector(const double* x, double* y) { *y = std::exp(*x); }
+#endif
+
+// Calculates y = exp(x) for n values, several at a time where possible
+void expArray(size_t n, const double* x, double* y)
+{
+    size_t i = 0;
+    for (; i + expWidth <= n; i += expWidth) {
+        expVector(x + i, y + i);
+    }
+    for (; i < n; ++i) {
+        y[i] = std::exp(x[i]);
+    }
+}
+}
+
 FiniteElementSpecHum FiniteElementSpecHum::m_water(
     6.1121e2, 18.729, 257.87, 227.3, 7.2e-4, 3.20e-6, 5.9e-10);
 FiniteElementSpecHum FiniteElementSpecHum::m_ice(
@@ -84,6 +166,100 @@ std::pair<double, double> FiniteElementSpecHum::calculate(
     return std::pair<double, double>(sphum, deriv);
 }
 
+void FiniteElementSpecHum::evaluate(
+    const HField& temperature, const HField& pressure, HField& out) const
+{
+    out.resize();
+    assert(temperature.trueSize() == out.trueSize());
+    assert(pressure.trueSize() == out.trueSize());
+    evaluate(
+        out.size(), temperature.getData(), pressure.getData(), nullptr, out.getData(), nullptr);
+}
+
+void FiniteElementSpecHum::evaluate(
+    const HField& temperature, const HField& pressure, const HField& salinity, HField& out) const
+{
+    out.resize();
+    assert(temperature.trueSize() == out.trueSize());
+    assert(pressure.trueSize() == out.trueSize());
+    assert(salinity.trueSize() == out.trueSize());
+    evaluate(out.size(), temperature.getData(), pressure.getData(), salinity.getData(),
+        out.getData(), nullptr);
+}
+
+void FiniteElementSpecHum::valueAndDerivative(
+    const HField& temperature, const HField& pressure, HField& out, HField& dOut) const
+{
+    out.resize();
+    dOut.resize();
+    assert(temperature.trueSize() == out.trueSize());
+    assert(pressure.trueSize() == out.trueSize());
+    evaluate(out.size(), temperature.getData(), pressure.getData(), nullptr, out.getData(),
+        dOut.getData());
+}
+
+void FiniteElementSpecHum::valueAndDerivative(const HField& temperature, const HField& pressure,
+    const HField& salinity, HField& out, HField& dOut) const
+{
+    out.resize();
+    dOut.resize();
+    assert(temperature.trueSize() == out.trueSize());
+    assert(pressure.trueSize() == out.trueSize());
+    assert(salinity.trueSize() == out.trueSize());
+    evaluate(out.size(), temperature.getData(), pressure.getData(), salinity.getData(),
+        out.getData(), dOut.getData());
+}
+
+void FiniteElementSpecHum::evaluate(size_t n, const double* temperature, const double* pressure,
+    const double* salinity, double* out, double* dOut) const
+{
+    const size_t nBlocks = (n + blockSize - 1) / blockSize;
+    // The same calculations as calculate(), rearranged into simple loops over
+    // a block of values so that they can be vectorized.
+#pragma omp parallel for
+    for (size_t block = 0; block < nBlocks; ++block) {
+        const size_t start = block * blockSize;
+        const size_t len = std::min(blockSize, n - start);
+        const double* t = temperature + start;
+        const double* p = pressure + start;
+        double* sphum = out + start;
+
+        double estCalc[blockSize];
+        for (size_t k = 0; k < len; ++k) {
+            estCalc[k] = (m_b - t[k] / m_d) * t[k] / (t[k] + m_c);
+        }
+        expArray(len, estCalc, estCalc);
+        if (salinity) {
+            const double* s = salinity + start;
+            for (size_t k = 0; k < len; ++k) {
+                estCalc[k] *= m_a * (1 - 5.37e-4 * s[k]);
+            }
+        } else {
+            for (size_t k = 0; k < len; ++k) {
+                estCalc[k] *= m_a;
+            }
+        }
+        double fCalc[blockSize];
+        for (size_t k = 0; k < len; ++k) {
+            fCalc[k] = 1 + m_bigA + p[k] * 0.01 * (m_bigB + m_bigC * t[k] * t[k]);
+            sphum[k] = m_alpha * fCalc[k] * estCalc[k] / (p[k] - m_beta * fCalc[k] * estCalc[k]);
+        }
+
+        if (dOut) {
+            double* deriv = dOut + start;
+            for (size_t k = 0; k < len; ++k) {
+                double df_dT = 2 * m_bigC * m_bigB * t[k];
+                double numerator = m_b * m_c * m_d - t[k] * (2 * m_c + t[k]);
+                double sqrtDenom = m_c + t[k];
+                double dest_dT = numerator / (m_d * sqrtDenom * sqrtDenom) * estCalc[k];
+                sqrtDenom = p[k] - m_beta * estCalc[k] * fCalc[k];
+                deriv[k] = m_alpha * p[k] * (fCalc[k] * dest_dT + estCalc[k] * df_dT)
+                    / (sqrtDenom * sqrtDenom);
+            }
+        }
+    }
+}
+
 // Specific humidity terms
 double FiniteElementSpecHum::f(double temperature, double pressurePa) const
 {
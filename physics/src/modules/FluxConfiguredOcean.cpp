@@ -77,7 +77,7 @@ void FluxConfiguredOcean::setData(const ModelState::DataMap& ms)
     mld = mld0;
     u = u0;
     v = v0;
-    tf = Module::getImplementation<IFreezingPoint>()(sss[0]);
+    Module::getImplementation<IFreezingPoint>()(sss, tf);
     cpml = Water::rho * Water::cp * mld[0];
 }
 
@@ -7,6 +7,7 @@
 
 #include "include/SMU2IceAlbedo.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace Nextsim {
@@ -31,4 +32,17 @@ std::tuple<double, double> SMU2IceAlbedo::albedo(
     }
     return {albedo, penSW};
 }
+
+void SMU2IceAlbedo::albedo(size_t n, const double* /*temperature*/, const double* snowThickness,
+    double i0, double* albedoOut, double* penSWOut)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const double snow = snowThickness[i];
+        const bool snowy = snow > 0.;
+        const double snowAlbedo
+            = std::min(SNOW_ALBEDO, ICE_ALBEDO + (SNOW_ALBEDO - ICE_ALBEDO) * snow / 0.2);
+        albedoOut[i] = snowy ? snowAlbedo : ICE_ALBEDO;
+        penSWOut[i] = snowy ? i0 : 0.;
+    }
+}
 }
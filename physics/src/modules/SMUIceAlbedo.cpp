@@ -27,4 +27,14 @@ std::tuple<double, double> SMUIceAlbedo::albedo(double temperature, double snowT
     }
     return {albedo, penSW};
 }
+
+void SMUIceAlbedo::albedo(size_t n, const double* /*temperature*/, const double* snowThickness,
+    double i0, double* albedoOut, double* penSWOut)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const bool snowy = snowThickness[i] > 0.;
+        albedoOut[i] = snowy ? SNOW_ALBEDO : ICE_ALBEDO;
+        penSWOut[i] = snowy ? 0. : i0;
+    }
+}
 }
@@ -10,7 +10,7 @@
 #include "include/IIceOceanHeatFlux.hpp"
 #include "include/IFreezingPoint.hpp"
 #include "include/Module.hpp"
-#include "include/ParaGridIO.hpp"
+#include "include/ParaGridForcing.hpp"
 #include "include/constants.hpp"
 
 namespace Nextsim {
@@ -19,23 +19,35 @@ std::string TOPAZOcean::filePath;
 
 static const std::string pfx = "TOPAZOcean";
 static const std::string fileKey = pfx + ".file";
+static const std::string prefetchKey = pfx + ".prefetch";
+static const std::string interpolateKey = pfx + ".interpolate";
 
 template <>
 const std::map<int, std::string> Configured<TOPAZOcean>::keyMap = {
     { TOPAZOcean::FILEPATH_KEY, fileKey },
+    { TOPAZOcean::PREFETCH_KEY, prefetchKey },
+    { TOPAZOcean::INTERPOLATE_KEY, interpolateKey },
 };
 
 TOPAZOcean::TOPAZOcean()
-    : sstExt(ModelArray::Type::H)
+    : prefetch(false)
+    , interpolate(false)
+    , sstExt(ModelArray::Type::H)
     , sssExt(ModelArray::Type::H)
 {
 }
 
+TOPAZOcean::~TOPAZOcean() = default;
+
 ConfigurationHelp::HelpMap& TOPAZOcean::getHelpRecursive(HelpMap& map, bool getAll)
 {
     map[pfx] = {
         { fileKey, ConfigType::STRING, {}, "", "",
             "Path to the processed NetCDF file providing the TOPAZ forcings." },
+        { prefetchKey, ConfigType::BOOLEAN, { "true", "false" }, "false", "",
+            "Read the next forcing record in the background while the current one is in use." },
+        { interpolateKey, ConfigType::BOOLEAN, { "true", "false" }, "false", "",
+            "Linearly interpolate the forcings in time between the bracketing records." },
     };
 
     return map;
@@ -44,6 +56,9 @@ ConfigurationHelp::HelpMap& TOPAZOcean::getHelpRecursive(HelpMap& map, bool getA
 void TOPAZOcean::configure()
 {
     filePath = Configured::getConfiguration(keyMap.at(FILEPATH_KEY), std::string());
+    prefetch = Configured::getConfiguration(keyMap.at(PREFETCH_KEY), false);
+    interpolate = Configured::getConfiguration(keyMap.at(INTERPOLATE_KEY), false);
+    forcingFile.reset();
 
     slabOcean.configure();
 
@@ -52,22 +67,34 @@ void TOPAZOcean::configure()
 
 }
 
-void TOPAZOcean::updateBefore(const TimestepTime& tst)
+void TOPAZOcean::updateForcing(const TimestepTime& tst)
 {
-    // TODO: Get more authoritative names for the forcings
-    std::set<std::string> forcings = { "sst", "sss", "mld", "u", "v" };
-
-    ModelState state = ParaGridIO::readForcingTimeStatic(forcings, tst.start, filePath);
-    sstExt = state.data.at("sst");
-    sssExt = state.data.at("sss");
-    mld = state.data.at("mld");
-    u = state.data.at("u");
-    v = state.data.at("v");
+    if (!forcingFile) {
+        // TODO: Get more authoritative names for the forcings
+        std::set<std::string> forcings = { "sst", "sss", "mld", "u", "v" };
+        forcingFile = std::make_unique<ParaGridForcing>(forcings, filePath);
+        forcingFile->setPrefetch(prefetch);
+        forcingFile->setInterpolate(interpolate);
+        // The forcing fields are written straight into the module arrays
+        forcingFile->bind("sst", sstExt);
+        forcingFile->bind("sss", sssExt);
+        forcingFile->bind("mld", mld);
+        forcingFile->bind("u", u);
+        forcingFile->bind("v", v);
+    }
+
+    // The forcing fields and the derived heat capacity only change when a new
+    // record is read, or the interpolation between records moves on
+    if (forcingFile->update(tst.start)) {
+        cpml = Water::rho * Water::cp * mld;
+    }
+}
 
-    cpml = Water::rho * Water::cp * mld;
-    overElements(std::bind(&TOPAZOcean::updateTf, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        TimestepTime());
+void TOPAZOcean::updateBefore(const TimestepTime& tst)
+{
+    // Does nothing if the forcing has already been read for this timestep
+    updateForcing(tst);
+    Module::getImplementation<IFreezingPoint>()(sss, tf);
 
     Module::getImplementation<IIceOceanHeatFlux>().update(tst);
 
@@ -81,20 +108,35 @@ void TOPAZOcean::updateAfter(const TimestepTime& tst)
 }
 
 
-void TOPAZOcean::setFilePath(const std::string& filePathIn) { filePath = filePathIn; }
+void TOPAZOcean::setFilePath(const std::string& filePathIn)
+{
+    filePath = filePathIn;
+    forcingFile.reset();
+}
+
+void TOPAZOcean::setPrefetch(bool doPrefetch)
+{
+    prefetch = doPrefetch;
+    if (forcingFile)
+        forcingFile->setPrefetch(prefetch);
+}
+
+void TOPAZOcean::setInterpolate(bool doInterpolate)
+{
+    interpolate = doInterpolate;
+    if (forcingFile)
+        forcingFile->setInterpolate(interpolate);
+}
 
 void TOPAZOcean::setData(const ModelState::DataMap& ms)
 {
     IOceanBoundary::setData(ms);
+    // Any held forcing record must be read again into the new arrays
+    forcingFile.reset();
 
     sstExt.resize();
     sssExt.resize();
     slabOcean.setData(ms);
 }
 
-void TOPAZOcean::updateTf(size_t i, const TimestepTime& tst)
-{
-    tf[i] = Module::getImplementation<IFreezingPoint>()(sss[i]);
-}
-
 } /* namespace Nextsim */
@@ -33,9 +33,11 @@ ThermoIce0::ThermoIce0()
 
 void ThermoIce0::update(const TimestepTime& tsTime)
 {
-    overElements(std::bind(&ThermoIce0::calculateElement, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        tsTime);
+    parallelOverActiveElements(
+        [this](size_t i, const TimestepTime& t) { calculateElement(i, t); }, tsTime);
+    // Elements with no ice and no new ice have nothing to calculate
+    parallelOverInactiveElements(
+        [this](size_t i, const TimestepTime&) { calculateIceFreeElement(i); }, tsTime);
 }
 
 template <>
@@ -85,9 +87,7 @@ void ThermoIce0::calculateElement(size_t i, const TimestepTime& tst)
 {
     // If there is too little ice, do nothing and zero out the computed arrays
     if (hice[i] == 0. || cice[i] == 0.) {
-        deltaHi[i] = 0.;
-        snowToIce[i] = 0.;
-
+        calculateIceFreeElement(i);
         return;
     }
 
@@ -169,5 +169,11 @@ void ThermoIce0::calculateElement(size_t i, const TimestepTime& tst)
     }
 }
 
+void ThermoIce0::calculateIceFreeElement(size_t i)
+{
+    deltaHi[i] = 0.;
+    snowToIce[i] = 0.;
+}
+
 size_t ThermoIce0::getNZLevels() const { return nZLevels; }
 } /* namespace Nextsim */
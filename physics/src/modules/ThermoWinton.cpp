@@ -16,6 +16,8 @@
 namespace Nextsim {
 
 const size_t ThermoWinton::nLevels = 3;
+// Eight doubles fill an AVX-512 register, or two AVX2 registers
+const size_t ThermoWinton::batchWidth = 8;
 double ThermoWinton::kappa_s;
 double ThermoWinton::i0;
 static const double k_sDefault = 0.3096;
@@ -24,6 +26,7 @@ static const double i0_default = 0.17;
 const double ThermoWinton::cVol = Ice::cp * Ice::rho; // bulk heat capacity of ice
 const double ThermoWinton::seaIceTf = -Water::mu * Ice::s;
 bool ThermoWinton::doFlooding = true;
+bool ThermoWinton::batched = false;
 
 ThermoWinton::ThermoWinton()
     : IIceThermodynamics()
@@ -40,6 +43,7 @@ const std::map<int, std::string> Configured<ThermoWinton>::keyMap = {
     { ThermoWinton::KS_KEY, IIceThermodynamics::getKappaSConfigKey() },
     { ThermoWinton::I0_KEY, "nextsim_thermo.I_0" },
     { ThermoWinton::FLOODING_KEY, "nextsim_thermo.doFlooding" },
+    { ThermoWinton::BATCHED_KEY, "ThermoWinton.batched" },
 };
 
 void ThermoWinton::configure()
@@ -47,6 +51,7 @@ void ThermoWinton::configure()
     kappa_s = Configured::getConfiguration(keyMap.at(KS_KEY), k_sDefault);
     i0 = Configured::getConfiguration(keyMap.at(I0_KEY), i0_default);
     doFlooding = Configured::getConfiguration(keyMap.at(FLOODING_KEY), doFlooding);
+    batched = Configured::getConfiguration(keyMap.at(BATCHED_KEY), false);
     NZLevels::set(nLevels);
 }
 
@@ -67,6 +72,9 @@ ThermoWinton::HelpMap& ThermoWinton::getHelpText(HelpMap& map, bool getAll)
             "W K⁻¹ m⁻¹", "Thermal conductivity of snow." },
         { keyMap.at(I0_KEY), ConfigType::NUMERIC, { "0", "1" }, std::to_string(i0_default),
             "unitless", "Optical albedo of liquid water." },
+        { keyMap.at(BATCHED_KEY), ConfigType::BOOLEAN, { "true", "false" }, "false", "",
+            "Calculate several ice columns at once using SIMD instructions. The ice "
+            "thermodynamics then cannot be fused with the rest of the ice growth calculation." },
     };
     return map;
 }
@@ -95,9 +103,19 @@ void ThermoWinton::setData(const ModelState::DataMap& state)
 
 void ThermoWinton::update(const TimestepTime& tst)
 {
-    overElements(std::bind(&ThermoWinton::calculateElement, this, std::placeholders::_1,
-                     std::placeholders::_2),
-        tst);
+    if (batched) {
+        parallelOverActiveElementBatches<batchWidth>(
+            [this](const size_t* index, size_t n, const TimestepTime& t) {
+                calculateBatch(index, n, t);
+            },
+            tst);
+    } else {
+        parallelOverActiveElements(
+            [this](size_t i, const TimestepTime& t) { calculateElement(i, t); }, tst);
+    }
+    // Elements with no ice and no new ice have nothing to calculate
+    parallelOverInactiveElements(
+        [this](size_t i, const TimestepTime&) { calculateIceFreeElement(i); }, tst);
 }
 
 size_t ThermoWinton::getNZLevels() const { return nLevels; }
@@ -107,17 +125,7 @@ void ThermoWinton::calculateElement(size_t i, const TimestepTime& tst)
 
     // Don't do anything if there is no ice
     if (cice[i] <= 0 || hice[i] <= 0) {
-
-        snowToIce[i] = 0;
-
-        deltaHi[i] = 0;
-        hice[i] = 0;
-        hsnow[i] = 0;
-
-        tice.zIndexAndLayer(i, 0) = seaIceTf;
-        tice.zIndexAndLayer(i, 1) = seaIceTf;
-        tice.zIndexAndLayer(i, 2) = seaIceTf;
-
+        calculateIceFreeElement(i);
         return;
     }
 
@@ -344,4 +352,228 @@ void ThermoWinton::calculateTemps(
     tLowr = (2 * dt * k32 * (tUppr + 2 * tf[i]) + hi * cVol * tLowr) / (6 * dt * k32 + hi * cVol);
 }
 
+void ThermoWinton::calculateIceFreeElement(size_t i)
+{
+    snowToIce[i] = 0;
+
+    deltaHi[i] = 0;
+    hice[i] = 0;
+    hsnow[i] = 0;
+
+    tice.zIndexAndLayer(i, 0) = seaIceTf;
+    tice.zIndexAndLayer(i, 1) = seaIceTf;
+    tice.zIndexAndLayer(i, 2) = seaIceTf;
+}
+
+void ThermoWinton::calculateBatch(const size_t* index, size_t n, const TimestepTime& tst)
+{
+    /*
+     * The calculations of calculateElement() and calculateTemps() for a batch
+     * of columns. The column data is gathered into fixed size Eigen arrays,
+     * with one lane per column, so that every operation is applied to all of
+     * the lanes at once with SIMD instructions. Each branch of the scalar
+     * code is replaced by calculating both alternatives and selecting between
+     * them lane by lane. Unused lanes are filled with an ice-free column and
+     * are not written back.
+     */
+    typedef Eigen::Array<double, batchWidth, 1> Lanes;
+    typedef Eigen::Array<bool, batchWidth, 1> Mask;
+
+    static const double bulkLHFusionSnow = Water::Lf * Ice::rhoSnow;
+    static const double bulkLHFusionIce = Water::Lf * Ice::rho;
+    const static double dHfTf_cp = Water::Lf * seaIceTf / Ice::cp;
+    const double dt = tst.step.seconds();
+
+    Lanes cIce, hiOld, hSnow, tSurf0, tUppr0, tLowr0, tBott, snowfallL, subli, qioL, qiaL, dQiaL,
+        penSwL, oldHiL, topMeltL, botMeltL, snowMeltL, snowToIceL;
+
+    // Gather
+    for (size_t l = 0; l < batchWidth; ++l) {
+        const bool used = l < n;
+        const size_t i = index[used ? l : 0];
+        cIce[l] = used ? cice[i] : 0.;
+        hiOld[l] = hice[i];
+        hSnow[l] = hsnow[i];
+        tSurf0[l] = tice0.zIndexAndLayer(i, 0);
+        tUppr0[l] = tice0.zIndexAndLayer(i, 1);
+        tLowr0[l] = tice0.zIndexAndLayer(i, 2);
+        tBott[l] = tf[i];
+        snowfallL[l] = snowfall[i];
+        subli[l] = subl[i];
+        qioL[l] = qio[i];
+        qiaL[l] = qia[i];
+        dQiaL[l] = dQia_dt[i];
+        penSwL[l] = penSw[i];
+        oldHiL[l] = oldHi[i];
+        topMeltL[l] = topMelt[i];
+        botMeltL[l] = botMelt[i];
+        snowMeltL[l] = snowMelt[i];
+        snowToIceL[l] = snowToIce[i];
+    }
+
+    const Mask noIce = (cIce <= 0) || (hiOld <= 0);
+
+    // calculateTemps()
+    const Lanes tMelt = (hSnow > 0).select(Lanes::Zero(), seaIceTf);
+    const Lanes k12 = 4 * Ice::kappa * kappa_s / (kappa_s * hiOld + 4 * Ice::kappa * hSnow); // (5)
+    const Lanes a = qiaL - tSurf0 * dQiaL; // (7)
+    const Lanes& b = dQiaL; // (8)
+    const Lanes k32 = 2 * Ice::kappa / hiOld; // (10)
+    const Lanes k12b = k12 + b;
+    const Lanes lowerDenom = 6 * dt * k32 + hiOld * cVol;
+    Lanes a1 = hiOld * cVol / (2 * dt) + k32 * (4 * dt * k32 + hiOld * cVol) / lowerDenom
+        + b * k12 / k12b; // (16)
+    Lanes b1 = -hiOld * (cVol * tUppr0 + Ice::Lf * Ice::rho * seaIceTf / tUppr0) / (2 * dt)
+        - penSwL - k32 * (4 * dt * k32 * tBott + hiOld * cVol * tLowr0) / lowerDenom
+        + a * k12 / k12b; // (17)
+    const Lanes c1 = hiOld * Ice::Lf * Ice::rho * seaIceTf / (2 * dt); // (18)
+    const Lanes tUpprFree = -(b1 + (b1 * b1 - 4 * a1 * c1).sqrt()) / (2 * a1); // (21)
+    const Lanes tSurfFree = (k12 * tUpprFree - a) / k12b; // (6)
+    // The surface melting case
+    a1 += k12 - k12 * b / k12b; // (19)
+    b1 -= k12 * tMelt + a * k12 / k12b; // (20)
+    const Lanes tUpprMelt = -(b1 + (b1 * b1 - 4 * a1 * c1).sqrt()) / (2 * a1); // (21)
+    const Mask surfaceMelting = tSurfFree > tMelt;
+    Lanes tSurf = surfaceMelting.select(tMelt, tSurfFree);
+    Lanes tUppr = surfaceMelting.select(tUpprMelt, tUpprFree);
+    const Lanes surfMelt
+        = surfaceMelting.select(k12 * (tUppr - tSurf) - (a + b * tSurf), 0.); // (22)
+    Lanes tLowr = (2 * dt * k32 * (tUppr + 2 * tBott) + hiOld * cVol * tLowr0) / lowerDenom; // (15)
+
+    // Thickness changes
+    Lanes h1 = hiOld / 2;
+    Lanes h2 = hiOld / 2;
+    const Lanes e1 = cVol * (tUppr - seaIceTf) - bulkLHFusionIce * (1 - seaIceTf / tUppr);
+    const Lanes e2 = cVol * (tLowr - seaIceTf) - bulkLHFusionIce;
+    Lanes hs = hSnow + snowfallL / Ice::rhoSnow * dt;
+
+    // Sublimation, 4 cases
+    const Lanes deltaSnow = subli * dt / Ice::rhoSnow;
+    Lanes deltaIce1 = (subli * dt - hs * Ice::rhoSnow) / Ice::rho;
+    Lanes deltaIce2 = deltaIce1 - h1;
+    const Mask snowOnly = deltaSnow <= hs;
+    const Mask upperIce = !snowOnly && (deltaIce1 <= h1);
+    const Mask lowerIce = !snowOnly && !upperIce && (deltaIce2 <= h2);
+    hs = snowOnly.select(hs - deltaSnow, 0.);
+    const Lanes h1Subl = snowOnly.select(h1, upperIce.select(h1 - deltaIce1, 0.));
+    h2 = (snowOnly || upperIce).select(h2, lowerIce.select(h2 - deltaIce2, 0.));
+    h1 = h1Subl;
+    Lanes topMeltI = (h1 + h2 - hiOld).max(0.); // (23)
+
+    // Bottom melt/freezing
+    const Lanes meltBottom = (qioL - 4 * Ice::kappa * (tBott - tLowr) / hiOld) * dt;
+    const Mask freezing = meltBottom <= 0.;
+    // The freezing case
+    const Lanes eBot = cVol * (tBott - seaIceTf) - bulkLHFusionIce; // (25)
+    const Lanes deltaIce2Frz = meltBottom / eBot; // (24)
+    const Lanes tLowrFrz = (deltaIce2Frz * tBott + h2 * tLowr) / (deltaIce2Frz + h2); // (26)
+    // The melting case, eqs. (31)-(32)
+    const Lanes deltaIce2Mlt = -(-meltBottom / e2).min(h2);
+    const Lanes deltaIce1Mlt = -(-(meltBottom + e2 * h2) / e1).max(0.).min(h1);
+    const Lanes snowMeltMlt
+        = -((meltBottom + e2 * h2 + e1 * h1) / bulkLHFusionSnow).max(0.).min(hs);
+    const Mask allMeltBottom = (h2 + h1 + hs - deltaIce2Mlt - deltaIce1Mlt - snowMeltMlt) <= 0.;
+    const Lanes qioMlt = allMeltBottom.select(
+        qioL - (meltBottom - bulkLHFusionSnow * hs + e1 * h1 + e2 * h2).max(0.) / dt, qioL); // (34)
+    tLowr = freezing.select(tLowrFrz, tLowr);
+    Lanes qioI = freezing.select(qioL, qioMlt);
+    Lanes snowMeltI = freezing.select(0., snowMeltMlt);
+    hs = freezing.select(hs, hs + snowMeltMlt);
+    h1 = freezing.select(h1, h1 + deltaIce1Mlt);
+    h2 = freezing.select(h2 + deltaIce2Frz, h2 + deltaIce2Mlt);
+    Lanes botMeltI = freezing.select(botMeltL, botMeltL + deltaIce1Mlt + deltaIce2Mlt);
+
+    // Melting at the surface, eqs. (27)-(30)
+    snowMeltI -= (surfMelt * dt / bulkLHFusionSnow).min(hs);
+    deltaIce1 = -(-(surfMelt * dt - bulkLHFusionSnow * hs) / e1).max(0.).min(h1);
+    deltaIce2 = -(-(surfMelt * dt - bulkLHFusionSnow * hs + e1 * h1) / e2).max(0.).min(h2);
+    const Mask allMeltSurface = (h2 + h1 + hs - deltaIce2 - deltaIce1 - snowMeltI) <= 0.;
+    qioI = allMeltSurface.select(
+        qioI - (surfMelt * dt - bulkLHFusionSnow * hs + e1 * h1 + e2 * h2).max(0.) / dt, qioI);
+    hs += snowMeltI;
+    h1 += deltaIce1;
+    h2 += deltaIce2;
+    topMeltI += deltaIce1 + deltaIce2;
+
+    // Snow to ice conversion
+    const Lanes freeboard
+        = (hiOld * (Water::rhoOcean - Ice::rho) - hs * Ice::rhoSnow) / Water::rhoOcean;
+    const Mask flooding = (freeboard < 0.) && Mask::Constant(doFlooding);
+    const Lanes deltaIce1Fld = (-freeboard).max(0.); // (36)
+    const Lanes f1Fld = 1 - deltaIce1Fld / (deltaIce1Fld + h1);
+    const Lanes tBarFld = f1Fld * (tUppr + dHfTf_cp / tUppr) + (1 - f1Fld) * seaIceTf; // (39)
+    const Lanes tUpprFld = (tBarFld - (tBarFld * tBarFld - 4 * dHfTf_cp).sqrt()) / 2; // (38)
+    hs = flooding.select(hs + (freeboard * Ice::rho / Ice::rhoSnow).min(0.), hs); // (35)
+    tUppr = flooding.select(tUpprFld, tUppr);
+    h1 = flooding.select(h1 + deltaIce1Fld, h1);
+    Lanes snowToIceI = flooding.select(snowToIceL + deltaIce1Fld, snowToIceL);
+
+    // Add up the half-layer thicknesses and adjust the temperatures to evenly
+    // divide the ice
+    Lanes hi = h1 + h2;
+    const Mask lowerToUpper = h2 > h1;
+    // Lower layer ice is added to the upper layer
+    const Lanes f1Upr = h1 / hi * 2;
+    const Lanes tBarUpr = f1Upr * (tUppr + dHfTf_cp / tUppr) + (1 - f1Upr) * tLowr; // (39)
+    const Lanes tUpprUpr = (tBarUpr - (tBarUpr * tBarUpr - 4 * dHfTf_cp).sqrt()) / 2; // (38)
+    // Upper layer ice is added to the lower layer
+    const Lanes f1Lwr = (2 * h1 - hi) / hi;
+    const Lanes tLowrLwr = f1Lwr * (tUppr + dHfTf_cp / tUppr) + (1 - f1Lwr) * tLowr; // (40)
+    // Melt from top and bottom if the lower layer temperature is too high
+    const Mask tooWarm = !lowerToUpper && (tLowrLwr > seaIceTf);
+    const Lanes deltaMelt = tooWarm.select(hi / 4 * Ice::cp * (tLowrLwr - seaIceTf) * tUppr
+            / (Ice::Lf * tUppr + (Ice::cp * tUppr - Ice::Lf) * (seaIceTf - tUppr)),
+        0.);
+    tUppr = lowerToUpper.select(tUpprUpr, tUppr);
+    tLowr = lowerToUpper.select(tLowr, tooWarm.select(seaIceTf, tLowrLwr));
+    topMeltI = tooWarm.select(topMeltI - deltaMelt, topMeltI);
+    botMeltI = tooWarm.select(botMeltI - deltaMelt, botMeltI);
+    hi = tooWarm.select(hi - 2 * deltaMelt, hi);
+    Lanes deltaHiI = hi - oldHiL;
+
+    // Remove very small ice thickness
+    const Mask tooThin = hi < IceMinima::h();
+    const Mask shrinking = tooThin && (deltaHiI < 0);
+    qioI = tooThin.select(qioI - (-bulkLHFusionSnow * hs + (e1 + e2) * hi / 2) / dt, qioI); // (30)
+    topMeltI = shrinking.select(topMeltI * (oldHiL / deltaHiI), topMeltI);
+    botMeltI = shrinking.select(botMeltI * (oldHiL / deltaHiI), botMeltI);
+    snowToIceI = tooThin.select(0., snowToIceI);
+    deltaHiI = tooThin.select(-oldHiL, deltaHiI);
+    hi = tooThin.select(0., hi);
+    hs = tooThin.select(0., hs);
+    tSurf = tooThin.select(seaIceTf, tSurf);
+    tUppr = tooThin.select(seaIceTf, tUppr);
+    tLowr = tooThin.select(seaIceTf, tLowr);
+
+    // Columns without ice are reset, and keep their previous melt and flux
+    // values
+    snowToIceI = noIce.select(0., snowToIceI);
+    deltaHiI = noIce.select(0., deltaHiI);
+    hi = noIce.select(0., hi);
+    hs = noIce.select(0., hs);
+    tSurf = noIce.select(seaIceTf, tSurf);
+    tUppr = noIce.select(seaIceTf, tUppr);
+    tLowr = noIce.select(seaIceTf, tLowr);
+    qioI = noIce.select(qioL, qioI);
+    topMeltI = noIce.select(topMeltL, topMeltI);
+    botMeltI = noIce.select(botMeltL, botMeltI);
+    snowMeltI = noIce.select(snowMeltL, snowMeltI);
+
+    // Scatter
+    for (size_t l = 0; l < n; ++l) {
+        const size_t i = index[l];
+        hice[i] = hi[l];
+        hsnow[i] = hs[l];
+        tice.zIndexAndLayer(i, 0) = tSurf[l];
+        tice.zIndexAndLayer(i, 1) = tUppr[l];
+        tice.zIndexAndLayer(i, 2) = tLowr[l];
+        qio[i] = qioI[l];
+        deltaHi[i] = deltaHiI[l];
+        snowToIce[i] = snowToIceI[l];
+        topMelt[i] = topMeltI[l];
+        botMelt[i] = botMeltI[l];
+        snowMelt[i] = snowMeltI[l];
+    }
+}
+
 } /* namespace Nextsim */
@@ -24,6 +24,21 @@ public:
      */
     std::tuple<double, double> albedo(double temperature, double snowThickness, double i0) override;
 
+    /*!
+     * @brief Calculates the CCSM ice surface short wave albedo for a
+     * contiguous array of elements.
+     *
+     * @param n The number of elements to be calculated.
+     * @param temperature The temperatures of the ice surface.
+     * @param snowThickness The true snow thicknesses on top of the ice.
+     * @param i0 The transmissivity of the ice.
+     * @param albedoOut The array to be filled with the albedo.
+     * @param penSWOut The array to be filled with the penetrating shortwave fraction.
+     */
+    void albedo(size_t n, const double* temperature, const double* snowThickness, double i0,
+        double* albedoOut, double* penSWOut) override;
+    using IIceAlbedo::albedo;
+
     void configure() override;
 
     ConfigMap getConfiguration() const override;
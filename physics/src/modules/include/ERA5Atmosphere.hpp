@@ -13,8 +13,12 @@
 #include "include/Configured.hpp"
 #include "include/IFluxCalculation.hpp"
 
+#include <memory>
+
 namespace Nextsim {
 
+class ParaGridForcing;
+
 /*!
  * A class to provided forcings from pre-processed forcings files based on ERA5
  * data.
@@ -22,10 +26,12 @@ namespace Nextsim {
 class ERA5Atmosphere : public IAtmosphereBoundary, public Configured<ERA5Atmosphere> {
 public:
     ERA5Atmosphere();
-    ~ERA5Atmosphere() = default;
+    ~ERA5Atmosphere();
 
     enum {
         FILEPATH_KEY,
+        PREFETCH_KEY,
+        INTERPOLATE_KEY,
     };
 
     void setData(const ModelState::DataMap&) override;
@@ -35,15 +41,27 @@ public:
 
     void configure() override;
 
+    //! Reads the forcing fields for the timestep
+    void updateForcing(const TimestepTime&) override;
     //! Calculates the fluxes from the given values
     void update(const TimestepTime&) override;
 
     void setFilePath(const std::string& filePathIn);
+    //! Sets whether the next forcing record is read in the background.
+    void setPrefetch(bool doPrefetch);
+    //! Sets whether the forcings are interpolated in time between records.
+    void setInterpolate(bool doInterpolate);
 
 private:
     // Since the configuration is global, it makes sense for the file path to
     // be static.
     static std::string filePath;
+    // The forcing file, held open between timesteps
+    std::unique_ptr<ParaGridForcing> forcingFile;
+    // Whether the next forcing record is read in the background
+    bool prefetch;
+    // Whether the forcings are interpolated in time between records
+    bool interpolate;
 
     HField tair;
     HField tdew;
@@ -37,6 +37,9 @@ public:
         , sh_water(ModelArray::Type::H)
         , sh_ice(ModelArray::Type::H)
         , dshice_dT(ModelArray::Type::H)
+        , tice_top(ModelArray::Type::H)
+        , alb_ice(ModelArray::Type::H)
+        , i0_ice(ModelArray::Type::H)
         , sst(getProtectedArray())
         , sss(getProtectedArray())
         , t_air(getProtectedArray())
@@ -59,6 +62,7 @@ public:
         DRAGICET_KEY,
         OCEANALBEDO_KEY,
         I0_KEY,
+        FUSED_KEY,
     };
     void configure() override;
 
@@ -84,6 +88,9 @@ public:
     //! Updates the atmospheric fluxes.
     void updateAtmosphere(const TimestepTime& tst);
 
+    //! Sets whether all the fluxes are calculated in a single pass over the elements.
+    void setFused(bool doFuse) { fused = doFuse; }
+
 private:
     // Owned diagnostic fields
     HField evap; // Open water evaporative mass flux [kg  m⁻²]
@@ -103,6 +110,11 @@ private:
     HField sh_water;
     HField sh_ice;
     HField dshice_dT;
+    // Temperature of the top ice layer, as an HField
+    HField tice_top;
+    // Ice surface albedo and penetrating shortwave fraction
+    HField alb_ice;
+    HField i0_ice;
     // Input fields
     ModelArrayRef<ProtectedArray::SST, MARConstBackingStore> sst;
     ModelArrayRef<ProtectedArray::SSS, MARConstBackingStore> sss;
@@ -121,6 +133,17 @@ private:
     void calculateOW(size_t i, const TimestepTime& tst);
     void calculateIce(size_t i, const TimestepTime& tst);
     void calculateAtmos(size_t i, const TimestepTime& tst);
+    // Calculates the specific humidities over the whole grid.
+    void updateSpecificHumidity();
+    // Calculates the ice albedo and penetrating shortwave fraction for the
+    // whole grid. Requires the top ice temperatures from updateSpecificHumidity()
+    void updateAlbedo(const TimestepTime& tst);
+    // Atmosphere, open water and ice fluxes for one element, without storing
+    // the intermediate values other than the specific humidities.
+    void calculateElement(size_t i, const TimestepTime& tst);
+
+    // Whether the fluxes are calculated in a single pass over the elements
+    bool fused = true;
 
     static double dragOcean_q;
     static double dragOcean_m(double windSpeed);
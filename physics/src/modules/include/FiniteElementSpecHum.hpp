@@ -10,6 +10,10 @@
 
 #include "ISpecificHumidity.hpp"
 
+#include "include/ModelArray.hpp"
+
+#include <cstddef>
+
 namespace Nextsim {
 
 class FiniteElementSpecHum : public ISpecificHumidity {
@@ -22,6 +26,81 @@ public:
     std::pair<double, double> valueAndDerivative(
         double temperature, double pressure, double salinity) const override;
 
+    /*!
+     * @brief Calculates humidity over fresh water or ice for every element of
+     * the arrays.
+     *
+     * @details The output arrays are resized to the current H field size,
+     * which the input arrays must already match.
+     *
+     * @param temperature Temperature of the water vapour [˚C]
+     * @param pressure Hydrostatic pressure [Pa]
+     * @param out The array to be filled with the specific humidity [kg kg⁻¹]
+     */
+    void evaluate(const HField& temperature, const HField& pressure, HField& out) const;
+    /*!
+     * @brief Calculates humidity over sea water for every element of the arrays.
+     *
+     * @details The output arrays are resized as for the fresh water version.
+     *
+     * @param temperature Temperature of the water vapour [˚C]
+     * @param pressure Hydrostatic pressure [Pa]
+     * @param salinity Salinity of the liquid water [PSU]
+     * @param out The array to be filled with the specific humidity [kg kg⁻¹]
+     */
+    void evaluate(const HField& temperature, const HField& pressure, const HField& salinity,
+        HField& out) const;
+    /*!
+     * @brief Calculates humidity and its temperature dependence over fresh
+     * water or ice for every element of the arrays.
+     *
+     * @details The output arrays are resized as for evaluate().
+     *
+     * @param temperature Temperature of the water vapour [˚C]
+     * @param pressure Hydrostatic pressure [Pa]
+     * @param out The array to be filled with the specific humidity [kg kg⁻¹]
+     * @param dOut The array to be filled with the temperature derivative of
+     *             the specific humidity [kg kg⁻¹ K⁻¹]
+     */
+    void valueAndDerivative(
+        const HField& temperature, const HField& pressure, HField& out, HField& dOut) const;
+    /*!
+     * @brief Calculates humidity and its temperature dependence over sea
+     * water for every element of the arrays.
+     *
+     * @details The output arrays are resized as for evaluate().
+     *
+     * @param temperature Temperature of the water vapour [˚C]
+     * @param pressure Hydrostatic pressure [Pa]
+     * @param salinity Salinity of the liquid water [PSU]
+     * @param out The array to be filled with the specific humidity [kg kg⁻¹]
+     * @param dOut The array to be filled with the temperature derivative of
+     *             the specific humidity [kg kg⁻¹ K⁻¹]
+     */
+    void valueAndDerivative(const HField& temperature, const HField& pressure,
+        const HField& salinity, HField& out, HField& dOut) const;
+
+    /*!
+     * @brief Calculates humidity, and optionally its temperature dependence,
+     * for n contiguous values.
+     *
+     * @details The exponential in the saturation vapour pressure is evaluated
+     * several values at a time, using AVX-512 or AVX2 instructions when the
+     * code is compiled for them.
+     *
+     * @param n The number of values to calculate.
+     * @param temperature Temperatures of the water vapour [˚C]
+     * @param pressure Hydrostatic pressures [Pa]
+     * @param salinity Salinities of the liquid water [PSU], or nullptr for
+     *                 fresh water or ice.
+     * @param out The buffer to be filled with the specific humidities [kg kg⁻¹]
+     * @param dOut The buffer to be filled with the temperature derivatives of
+     *             the specific humidities [kg kg⁻¹ K⁻¹], or nullptr if these
+     *             are not required.
+     */
+    void evaluate(size_t n, const double* temperature, const double* pressure,
+        const double* salinity, double* out, double* dOut) const;
+
     //! Returns a static instance already constructed to calculate specific
     //! humidity over liquid water.
     static FiniteElementSpecHum& water() { return m_water; }
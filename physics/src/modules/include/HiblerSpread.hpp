@@ -34,9 +34,9 @@ public:
     static HelpMap& getHelpRecursive(HelpMap&, bool getAll);
 
     void freeze(const TimestepTime& tstep, double hice, double hsnow, double deltaHi, double newIce,
-        double& cice, double& qow, double& deltaCfreeze) override;
+        double& cice, double& qow, double& deltaCfreeze) final;
     void melt(const TimestepTime& tstep, double hice, double hsnow, double deltaHi, double& cice,
-        double& qow, double& deltaCmelt) override;
+        double& qow, double& deltaCmelt) final;
 
 private:
     static double h0;
@@ -67,6 +67,18 @@ public:
         vwind.resize();
         penSW.resize();
     }
+    /*!
+     * @brief Reads any external forcing for this timestep.
+     *
+     * @details Depends on no other model data, so it can run at the same time
+     * as the forcing updates of other components. Any NetCDF file access is
+     * serialized by the NetCDF lock, so only the work outside it overlaps.
+     * Implementations must also read the forcing in update() if it has not
+     * already been read for this timestep.
+     *
+     * @param tst The timestep start and duration.
+     */
+    virtual void updateForcing(const TimestepTime& /*tst*/) { }
     virtual void update(const TimestepTime& tst) { }
 
 protected:
@@ -9,7 +9,9 @@
 #ifndef IICEALBEDO_HPP
 #define IICEALBEDO_HPP
 
+#include "include/ModelArray.hpp"
 #include "include/Time.hpp"
+#include <cstddef>
 #include <tuple>
 
 namespace Nextsim {
@@ -27,6 +29,49 @@ public:
     virtual std::tuple<double, double> albedo(double temperature, double snowThickness, double i0)
         = 0;
 
+    /*!
+     * @brief A virtual function that calculates the ice surface short wave
+     * albedo and penetrating shortwave fraction for a contiguous array of
+     * elements.
+     *
+     * @details The default implementation calls the single element function
+     * for each element. Implementations should override this with a loop
+     * that the compiler can vectorize.
+     *
+     * @param n The number of elements to be calculated.
+     * @param temperature The temperatures of the ice surface.
+     * @param snowThickness The true snow thicknesses on top of the ice.
+     * @param i0 The transmissivity of the ice.
+     * @param albedoOut The array to be filled with the albedo.
+     * @param penSWOut The array to be filled with the fraction of the
+     *                 shortwave that penetrates the ice.
+     */
+    virtual void albedo(size_t n, const double* temperature, const double* snowThickness,
+        double i0, double* albedoOut, double* penSWOut)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            std::tie(albedoOut[i], penSWOut[i]) = albedo(temperature[i], snowThickness[i], i0);
+        }
+    }
+
+    /*!
+     * @brief Calculates the ice surface short wave albedo and penetrating
+     * shortwave fraction for whole fields.
+     *
+     * @param temperature The temperature of the ice surface.
+     * @param snowThickness The true snow thickness on top of the ice.
+     * @param i0 The transmissivity of the ice.
+     * @param albedoOut The array to be filled with the albedo.
+     * @param penSWOut The array to be filled with the fraction of the
+     *                 shortwave that penetrates the ice.
+     */
+    void albedo(const ModelArray& temperature, const ModelArray& snowThickness, double i0,
+        ModelArray& albedoOut, ModelArray& penSWOut)
+    {
+        albedo(temperature.size(), temperature.getData(), snowThickness.getData(), i0,
+            albedoOut.getData(), penSWOut.getData());
+    }
+
     /*!
      * Sets the time parameter for the implementation, if it is time dependent.
      * @param time The desired TimePoint.
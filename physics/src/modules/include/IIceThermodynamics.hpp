@@ -40,6 +40,19 @@ public:
      */
     virtual void update(const TimestepTime& tsTime) = 0;
 
+    /*!
+     * @brief Updates the ice thermodynamics of a single element.
+     *
+     * @details Only called when hasElementUpdate() returns true, in which
+     * case calling this for every ocean element must be equivalent to calling
+     * update(). This allows the thermodynamics to be fused with the other
+     * per-element parts of the ice growth calculation. The default does
+     * nothing, as it is never called.
+     */
+    virtual void updateElement(size_t, const TimestepTime&) { }
+    //! Returns whether the implementation provides updateElement().
+    virtual bool hasElementUpdate() const { return false; }
+
     inline static std::string getKappaSConfigKey() { return "thermo.ks"; }
 
     virtual size_t getNZLevels() const = 0;
@@ -13,8 +13,12 @@
 #include "include/Configured.hpp"
 #include "include/SlabOcean.hpp"
 
+#include <memory>
+
 namespace Nextsim {
 
+class ParaGridForcing;
+
 /*!
  * A class to provided forcings from pre-processed forcings files based on ERA5
  * data.
@@ -22,10 +26,12 @@ namespace Nextsim {
 class TOPAZOcean : public IOceanBoundary, public Configured<TOPAZOcean> {
 public:
     TOPAZOcean();
-    ~TOPAZOcean() = default;
+    ~TOPAZOcean();
 
     enum {
         FILEPATH_KEY,
+        PREFETCH_KEY,
+        INTERPOLATE_KEY,
     };
 
     void setData(const ModelState::DataMap&) override;
@@ -35,17 +41,26 @@ public:
 
     void configure() override;
 
+    void updateForcing(const TimestepTime&) override;
     void updateBefore(const TimestepTime&) override;
     void updateAfter(const TimestepTime&) override;
 
     void setFilePath(const std::string& filePathIn);
+    //! Sets whether the next forcing record is read in the background.
+    void setPrefetch(bool doPrefetch);
+    //! Sets whether the forcings are interpolated in time between records.
+    void setInterpolate(bool doInterpolate);
 
 private:
-    // Updates the freezing point of an element
-    void updateTf(size_t i, const TimestepTime& tst);
     // Since the configuration is global, it makes sense for the file path to
     // be static.
     static std::string filePath;
+    // The forcing file, held open between timesteps
+    std::unique_ptr<ParaGridForcing> forcingFile;
+    // Whether the next forcing record is read in the background
+    bool prefetch;
+    // Whether the forcings are interpolated in time between records
+    bool interpolate;
 
     HField sstExt;
     HField sssExt;
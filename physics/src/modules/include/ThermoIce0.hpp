@@ -31,11 +31,15 @@ public:
 
     void setData(const ModelState::DataMap&) override;
     void update(const TimestepTime& tsTime) override;
+    void updateElement(size_t i, const TimestepTime& tst) final { calculateElement(i, tst); }
+    bool hasElementUpdate() const override { return true; }
 
     size_t getNZLevels() const override;
 
 private:
     void calculateElement(size_t i, const TimestepTime& tst);
+    // Zero out the computed arrays in an element with no ice
+    void calculateIceFreeElement(size_t i);
 
     HField snowMelt;
     HField topMelt;
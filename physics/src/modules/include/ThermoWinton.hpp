@@ -25,6 +25,7 @@ public:
         KS_KEY,
         I0_KEY,
         FLOODING_KEY,
+        BATCHED_KEY,
     };
     void configure() override;
 
@@ -35,11 +36,18 @@ public:
 
     void setData(const ModelState::DataMap&) override;
     void update(const TimestepTime& tsTime) override;
+    void updateElement(size_t i, const TimestepTime& tst) final { calculateElement(i, tst); }
+    // The batched calculation can only be applied over the whole grid
+    bool hasElementUpdate() const override { return !batched; }
 
     size_t getNZLevels() const override;
 
 private:
     void calculateElement(size_t i, const TimestepTime& tst);
+    // The same calculation as calculateElement for up to batchWidth columns at once
+    void calculateBatch(const size_t* index, size_t n, const TimestepTime& tst);
+    // Reset the computed arrays and the ice temperatures in an element with no ice
+    void calculateIceFreeElement(size_t i);
 
     HField snowMelt;
     HField topMelt;
@@ -53,6 +61,8 @@ private:
     static bool doFlooding;
     static const double seaIceTf;
     static double kappa_s;
+    static bool batched;
+    static const size_t batchWidth;
 
     void calculateTemps(
         double& tSurf, double& tMidt, double& tBotn, double& mSurf, size_t i, double dt);
@@ -13,10 +13,13 @@
 #include "include/IFluxCalculation.hpp"
 #include "include/ModelArrayRef.hpp"
 #include "include/Module.hpp"
+#include "include/ParaGridForcing.hpp"
 #include "include/Time.hpp"
 
 #include <filesystem>
 #include <memory>
+#include <set>
+#include <vector>
 
 #define TO_STR(s) TO_STRI(s)
 #define TO_STRI(s) #s
@@ -26,25 +29,32 @@
 
 namespace Nextsim {
 
-TEST_SUITE_BEGIN("ERA5Atmosphere");
-TEST_CASE("ERA5Atmosphere construction test")
+// The size of the test forcing file
+static const size_t nx = 128;
+static const size_t ny = 128;
+
+/*
+ * Copies the test forcing file from the test source directory to the working
+ * directory, and sets the array sizes to match it. In the real model, the
+ * array sizes will have been set by the restart file by this point.
+ */
+static void prepareForcingFile(const std::string& filePath)
 {
-    std::string filePath = "era5_test128x128.nc";
     std::string sourceDir = TO_STR(TEST_FILE_SOURCE);
-    // Copy the test file from the test source directory to the working directory
     if (!std::filesystem::exists(filePath)) {
         std::filesystem::copy(sourceDir + "/" + filePath, ".");
     }
-    // In the real model, the array sizes will have been set by the restart file by this point
-    size_t nx = 128;
-    size_t ny = 128;
-    size_t nxvertex = nx + 1;
-    size_t nyvertex = ny + 1;
-
     ModelArray::setDimension(ModelArray::Dimension::X, nx);
     ModelArray::setDimension(ModelArray::Dimension::Y, ny);
-    ModelArray::setDimension(ModelArray::Dimension::XVERTEX, nxvertex);
-    ModelArray::setDimension(ModelArray::Dimension::YVERTEX, nyvertex);
+    ModelArray::setDimension(ModelArray::Dimension::XVERTEX, nx + 1);
+    ModelArray::setDimension(ModelArray::Dimension::YVERTEX, ny + 1);
+}
+
+TEST_SUITE_BEGIN("ERA5Atmosphere");
+TEST_CASE("ERA5Atmosphere construction test")
+{
+    std::string filePath = "era5_test128x128.nc";
+    prepareForcingFile(filePath);
 
     ERA5Atmosphere e5;
 
@@ -120,5 +130,133 @@ TEST_CASE("ERA5Atmosphere construction test")
 
     std::filesystem::remove(filePath);
 }
+
+TEST_CASE("ERA5 forcing file record caching")
+{
+    std::string filePath = "era5_test128x128.nc";
+    prepareForcingFile(filePath);
+
+    ParaGridForcing forcingFile({ "wind_speed" }, filePath);
+
+    // 12 records, 30 days apart
+    REQUIRE(forcingFile.nRecords() == 12);
+    TimePoint t1("2000-01-01T00:00:00Z");
+    REQUIRE(forcingFile.recordTime(0) == t1);
+    REQUIRE(forcingFile.recordIndex(t1) == 0);
+    REQUIRE(forcingFile.recordIndex(TimePoint("1999-01-01T00:00:00Z")) == 0);
+    REQUIRE(forcingFile.recordIndex(TimePoint("2000-01-30T23:59:59Z")) == 0);
+    REQUIRE(forcingFile.recordIndex(TimePoint("2000-01-31T00:00:00Z")) == 1);
+    REQUIRE(forcingFile.recordIndex(TimePoint("2010-01-01T00:00:00Z")) == 11);
+
+    // The first update reads a record
+    REQUIRE(forcingFile.currentRecord() == ParaGridForcing::noRecord);
+    REQUIRE(forcingFile.update(t1));
+    REQUIRE(forcingFile.currentRecord() == 0);
+    const ModelArray& wind = forcingFile.state().data.at("wind_speed");
+    REQUIRE(wind(12, 12) == 12.012);
+
+    // Later timesteps in the same record do not read the file again
+    for (int step = 1; step < 30; ++step) {
+        REQUIRE_FALSE(forcingFile.update(t1 + Duration(120. * step)));
+    }
+    REQUIRE(wind(12, 12) == 12.012);
+
+    // A new record is read into the same array
+    REQUIRE(forcingFile.update(TimePoint("2000-02-01T00:00:00Z")));
+    REQUIRE(forcingFile.currentRecord() == 1);
+    REQUIRE(wind(12, 12) == 12.012 + 100);
+
+    std::filesystem::remove(filePath);
+}
+
+TEST_CASE("ERA5 forcing file background prefetch")
+{
+    std::string filePath = "era5_test128x128.nc";
+    prepareForcingFile(filePath);
+
+    std::set<std::string> forcings = { "wind_speed", "pair" };
+    ParaGridForcing direct(forcings, filePath);
+    ParaGridForcing prefetched(forcings, filePath);
+    prefetched.setPrefetch(true);
+    REQUIRE(prefetched.prefetch());
+
+    const ModelArray& wind = prefetched.state().data.at("wind_speed");
+    // Daily steps through the year, plus a jump backwards, which cannot use
+    // the prefetched record
+    TimePoint t1("2000-01-01T00:00:00Z");
+    std::vector<TimePoint> times;
+    for (int day = 0; day < 366; ++day) {
+        times.push_back(t1 + Duration(86400. * day));
+    }
+    times.push_back(t1 + Duration(86400. * 45));
+    for (const TimePoint& time : times) {
+        REQUIRE(prefetched.update(time) == direct.update(time));
+        REQUIRE(prefetched.currentRecord() == direct.currentRecord());
+        for (const std::string& name : forcings) {
+            const ModelArray& a = prefetched.state().data.at(name);
+            const ModelArray& b = direct.state().data.at(name);
+            REQUIRE(a(0, 0) == b(0, 0));
+            REQUIRE(a(12, 12) == b(12, 12));
+            REQUIRE(a(nx - 1, ny - 1) == b(nx - 1, ny - 1));
+        }
+        // References into the held state follow the swapped buffers
+        REQUIRE(wind(12, 12) == direct.state().data.at("wind_speed")(12, 12));
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST_CASE("ERA5 forcing time interpolation")
+{
+    std::string filePath = "era5_test128x128.nc";
+    prepareForcingFile(filePath);
+
+    ParaGridForcing forcingFile({ "wind_speed" }, filePath);
+    forcingFile.setInterpolate(true);
+    REQUIRE(forcingFile.interpolate());
+    const ModelArray& wind = forcingFile.state().data.at("wind_speed");
+
+    // On a record, the fields are those of the record
+    TimePoint t1("2000-01-01T00:00:00Z");
+    REQUIRE(forcingFile.update(t1));
+    REQUIRE(wind(12, 12) == 12.012);
+    // The same time does not change the fields
+    REQUIRE_FALSE(forcingFile.update(t1));
+
+    // Between records, the fields are linearly interpolated. Records are 30 days apart.
+    const double day = 86400.;
+    REQUIRE(forcingFile.update(t1 + Duration(15 * day)));
+    REQUIRE(forcingFile.currentRecord() == 0);
+    REQUIRE(wind(12, 12) == doctest::Approx(12.012 + 50));
+    REQUIRE(forcingFile.update(t1 + Duration(36 * day)));
+    REQUIRE(forcingFile.currentRecord() == 1);
+    REQUIRE(wind(12, 12) == doctest::Approx(12.012 + 120));
+    REQUIRE(wind(30, 20) == doctest::Approx(20.030 + 120));
+
+    // After the last record, the fields are those of the last record
+    REQUIRE(forcingFile.update(TimePoint("2010-01-01T00:00:00Z")));
+    REQUIRE(wind(12, 12) == doctest::Approx(12.012 + 100 * 11));
+
+    // Prefetching the records gives the same fields, as does blending them
+    // directly into a bound array
+    ParaGridForcing prefetched({ "wind_speed" }, filePath);
+    prefetched.setInterpolate(true);
+    prefetched.setPrefetch(true);
+    HField boundWind(ModelArray::Type::H);
+    ParaGridForcing bound({ "wind_speed" }, filePath);
+    bound.setInterpolate(true);
+    bound.bind("wind_speed", boundWind);
+    for (int hour = 0; hour < 24 * 100; hour += 7) {
+        TimePoint time = t1 + Duration(3600. * hour);
+        bool changed = forcingFile.update(time);
+        REQUIRE(prefetched.update(time) == changed);
+        REQUIRE(bound.update(time) == changed);
+        REQUIRE(prefetched.state().data.at("wind_speed")(12, 12) == wind(12, 12));
+        REQUIRE(boundWind(12, 12) == wind(12, 12));
+    }
+    REQUIRE(bound.state().data.count("wind_speed") == 0);
+
+    std::filesystem::remove(filePath);
+}
 TEST_SUITE_END();
 }
@@ -11,6 +11,7 @@
 
 #include "include/FiniteElementFluxes.hpp"
 
+#include "include/CCSMIceAlbedo.hpp"
 #include "include/Configurator.hpp"
 #include "include/ConfiguredModule.hpp"
 #include "include/IFreezingPointModule.hpp"
@@ -18,6 +19,8 @@
 #include "include/ModelArray.hpp"
 #include "include/ModelArrayRef.hpp"
 #include "include/ModelComponent.hpp"
+#include "include/SMU2IceAlbedo.hpp"
+#include "include/SMUIceAlbedo.hpp"
 #include "include/Time.hpp"
 #include "include/UnescoFreezing.hpp"
 #include "include/constants.hpp"
@@ -334,6 +337,211 @@ TEST_CASE("Freezing conditions")
     REQUIRE(dqia_dt[0] == doctest::Approx(16.7615).epsilon(prec));
     REQUIRE(subl[0] == doctest::Approx(2.15132e-6).epsilon(prec));
 }
+// Sets the elements of a field in order from a list of values
+static void setValues(ModelArray& field, std::initializer_list<double> values)
+{
+    size_t i = 0;
+    for (double value : values) {
+        field[i++] = value;
+    }
+}
+
+TEST_CASE("Fused and split passes")
+{
+    ModelArray::setDimensions(ModelArray::Type::H, { 2, 2 });
+    ModelArray::setDimensions(ModelArray::Type::Z, { 2, 2, 1 });
+
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "Nextsim::IFreezingPoint = Nextsim::UnescoFreezing" << std::endl;
+    config << "Nextsim::IIceAlbedo = Nextsim::CCSMIceAlbedo" << std::endl;
+
+    std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+    Configurator::addStream(std::move(pcstream));
+
+    ConfiguredModule::parseConfigurator();
+
+    class OceanData : public IOceanBoundary {
+    public:
+        OceanData()
+            : IOceanBoundary()
+        {
+        }
+        void setData(const ModelState::DataMap& state) override
+        {
+            IOceanBoundary::setData(state);
+            UnescoFreezing uf;
+            setValues(sst, { -1., -1.5, 0.5, -1.75 });
+            setValues(sss, { 32., 33., 31., 34. });
+            mld = 10.25;
+            for (size_t i = 0; i < tf.size(); ++i) {
+                tf[i] = uf(sss[i]);
+            }
+            cpml = Water::cp * Water::rho * mld[0];
+            u = 0;
+            v = 0;
+        }
+        void updateBefore(const TimestepTime&) override { }
+        void updateAfter(const TimestepTime&) override { }
+    } ocnBdy;
+    ocnBdy.setData(ModelState().data);
+
+    class AtmosphereData : public ModelComponent {
+    public:
+        AtmosphereData()
+        {
+            registerProtectedArray(ProtectedArray::T_AIR, &tair);
+            registerProtectedArray(ProtectedArray::DEW_2M, &tdew);
+            registerProtectedArray(ProtectedArray::P_AIR, &pair);
+            registerProtectedArray(ProtectedArray::WIND_SPEED, &windSpeed);
+            registerProtectedArray(ProtectedArray::SW_IN, &sw_in);
+            registerProtectedArray(ProtectedArray::LW_IN, &lw_in);
+        }
+        void setData(const ModelState::DataMap&) override
+        {
+            tair.resize();
+            tdew.resize();
+            pair.resize();
+            windSpeed.resize();
+            sw_in.resize();
+            lw_in.resize();
+
+            setValues(tair, { 3., -12., -5., 1. });
+            setValues(tdew, { 2., -12., -6., 0. });
+            setValues(pair, { 100000., 101000., 99000., 100500. });
+            setValues(windSpeed, { 5., 5., 12., 2. });
+            setValues(sw_in, { 50., 0., 200., 120. });
+            setValues(lw_in, { 330., 265., 290., 310. });
+        }
+        std::string getName() const override { return "AtmData"; }
+        ModelState getState() const override { return ModelState(); }
+        ModelState getState(const OutputLevel&) const override { return getState(); }
+
+    private:
+        HField tair;
+        HField tdew;
+        HField pair;
+        HField windSpeed;
+        HField sw_in;
+        HField lw_in;
+    } atmState;
+    atmState.setData(ModelState().data);
+
+    class ProgData : public ModelComponent {
+    public:
+        ProgData()
+        {
+            registerProtectedArray(ProtectedArray::C_ICE, &cice);
+            registerProtectedArray(ProtectedArray::H_SNOW, &hsnow);
+            registerProtectedArray(ProtectedArray::T_ICE, &tice0);
+            registerProtectedArray(ProtectedArray::HTRUE_SNOW, &hsnow0);
+        }
+        std::string getName() const override { return "ProgData"; }
+
+        void setData(const ModelState::DataMap&) override
+        {
+            // One land point, which neither pass should touch
+            ModelArray mask(ModelArray::Type::H);
+            mask.resize();
+            setValues(mask, { 1., 1., 0., 1. });
+            setOceanMask(mask);
+            setValues(cice, { 0.5, 0.9, 0., 0.2 });
+            setValues(hsnow, { 0.01, 0.1, 0., 0. });
+            setValues(tice0, { -1., -9., -3., -0.5 });
+            hsnow0 = hsnow;
+        }
+
+        HField cice;
+        HField hsnow;
+        HField tice0;
+        HField hsnow0; // ice averaged snow thickness
+        ModelState getState() const override { return ModelState(); }
+        ModelState getState(const OutputLevel&) const override { return getState(); }
+    } iceState;
+
+    HField qow;
+    qow.resize();
+    ModelComponent::registerExternalSharedArray(ModelComponent::SharedArray::Q_OW, &qow);
+
+    HField qia;
+    qia.resize();
+    ModelComponent::registerExternalSharedArray(ModelComponent::SharedArray::Q_IA, &qia);
+
+    HField penSW;
+    penSW.resize();
+    ModelComponent::registerExternalSharedArray(ModelComponent::SharedArray::Q_PEN_SW, &penSW);
+
+    HField dqia_dt;
+    dqia_dt.resize();
+    ModelComponent::registerExternalSharedArray(ModelComponent::SharedArray::DQIA_DT, &dqia_dt);
+
+    HField subl;
+    subl.resize();
+    ModelComponent::registerExternalSharedArray(ModelComponent::SharedArray::SUBLIM, &subl);
+
+    TimestepTime tst = { TimePoint("2000-001"), Duration("P0-0T0:10:0") };
+    FiniteElementFluxes fef;
+    fef.configure();
+    fef.setData(ModelState().data);
+    // Constructing a ModelComponent resets the land mask, so set it afterwards
+    iceState.setData(ModelState().data);
+
+    const double landValue = -999.;
+    std::vector<HField*> outputs = { &qow, &qia, &penSW, &dqia_dt, &subl };
+    for (HField* field : outputs) {
+        *field = landValue;
+    }
+    fef.setFused(false);
+    fef.update(tst);
+    std::vector<HField> split;
+    for (HField* field : outputs) {
+        split.push_back(*field);
+        *field = landValue;
+    }
+    fef.setFused(true);
+    fef.update(tst);
+
+    for (size_t f = 0; f < outputs.size(); ++f) {
+        REQUIRE((*outputs[f])[2] == landValue);
+        for (size_t i = 0; i < qow.size(); ++i) {
+            REQUIRE((*outputs[f])[i] == doctest::Approx(split[f][i]).epsilon(1e-12));
+        }
+    }
+    // The mixture of ice and open water conditions is actually exercised
+    REQUIRE(qow[0] != qow[1]);
+    REQUIRE(penSW[3] > 0.);
+}
+
+TEST_CASE("Array ice albedo")
+{
+    ModelArray::setDimensions(ModelArray::Type::H, { 3, 4 });
+    HField tSurf(ModelArray::Type::H);
+    HField hSnow(ModelArray::Type::H);
+    tSurf.resize();
+    hSnow.resize();
+    for (size_t i = 0; i < tSurf.size(); ++i) {
+        tSurf[i] = -4. + 0.4 * i;
+        hSnow[i] = (i % 3) * 0.15;
+    }
+    HField albedo(ModelArray::Type::H);
+    HField penSW(ModelArray::Type::H);
+    albedo.resize();
+    penSW.resize();
+    const double i0 = 0.17;
+
+    CCSMIceAlbedo ccsm;
+    SMUIceAlbedo smu;
+    SMU2IceAlbedo smu2;
+    for (IIceAlbedo* impl : std::initializer_list<IIceAlbedo*> { &ccsm, &smu, &smu2 }) {
+        impl->albedo(tSurf, hSnow, i0, albedo, penSW);
+        for (size_t i = 0; i < tSurf.size(); ++i) {
+            double albedoValue, penSWValue;
+            std::tie(albedoValue, penSWValue) = impl->albedo(tSurf[i], hSnow[i], i0);
+            REQUIRE(albedo[i] == doctest::Approx(albedoValue).epsilon(1e-12));
+            REQUIRE(penSW[i] == doctest::Approx(penSWValue).epsilon(1e-12));
+        }
+    }
+}
 TEST_SUITE_END();
 
 }
@@ -0,0 +1,48 @@
+/*!
+ * @file FreezingPoint_test.cpp
+ *
+ * @date Oct 17, 2026
+ * @author Tim Spain <timothy.spain@nersc.no>
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "include/LinearFreezing.hpp"
+#include "include/ModelArray.hpp"
+#include "include/UnescoFreezing.hpp"
+
+namespace Nextsim {
+
+TEST_SUITE_BEGIN("FreezingPoint");
+TEST_CASE("Freezing point fields")
+{
+    const size_t nx = 5;
+    const size_t ny = 3;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+
+    HField sss(ModelArray::Type::H);
+    sss.resize();
+    for (size_t i = 0; i < sss.size(); ++i) {
+        sss[i] = 2.5 * i;
+    }
+    HField tf(ModelArray::Type::H);
+
+    LinearFreezing linear;
+    linear(sss, tf);
+    REQUIRE(tf.size() == sss.size());
+    for (size_t i = 0; i < sss.size(); ++i) {
+        REQUIRE(tf[i] == doctest::Approx(linear(sss[i])).epsilon(1e-12));
+    }
+
+    UnescoFreezing unesco;
+    unesco(sss, tf);
+    REQUIRE(tf.size() == sss.size());
+    for (size_t i = 0; i < sss.size(); ++i) {
+        REQUIRE(tf[i] == doctest::Approx(unesco(sss[i])).epsilon(1e-12));
+    }
+    // Standard seawater freezes at about -1.92˚C
+    REQUIRE(unesco(35) == doctest::Approx(-1.922).epsilon(1e-3));
+}
+TEST_SUITE_END();
+} /* namespace Nextsim */
@@ -7,7 +7,9 @@
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
+#include <chrono>
 #include <sstream>
+#include <utility>
 
 #include "include/IceGrowth.hpp"
 
@@ -20,6 +22,8 @@
 #include "include/ModelArray.hpp"
 #include "include/ModelArrayRef.hpp"
 #include "include/ModelComponent.hpp"
+#include "include/Module.hpp"
+#include "include/ThermoIce0.hpp"
 #include "include/Time.hpp"
 #include "include/UnescoFreezing.hpp"
 #include "include/constants.hpp"
@@ -739,6 +743,252 @@ TEST_CASE("Turn off thermo")
     REQUIRE(newice[0] == 0.0);
 }
 
+// ThermoIce0, but only able to update the whole grid at once
+class ThermoIce0Unfused : public ThermoIce0 {
+public:
+    bool hasElementUpdate() const override { return false; }
+};
+
+// Configures the ice growth, with or without the active cell lists
+static void setGrowthConfig(bool activeCells)
+{
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "Nextsim::ILateralIceSpread = Nextsim::HiblerSpread" << std::endl;
+    config << std::endl;
+    config << "[nextsim_thermo]" << std::endl;
+    config << "use_thermo_forcing = true" << std::endl;
+    config << std::endl;
+    config << "[IceGrowth]" << std::endl;
+    config << "activeCells = " << (activeCells ? "true" : "false") << std::endl;
+
+    Configurator::clear();
+    std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+    Configurator::addStream(std::move(pcstream));
+
+    ConfiguredModule::parseConfigurator();
+}
+
+// Freezing and melting conditions, varying across the grid
+class GrowthAtmosphere : public IAtmosphereBoundary {
+public:
+    GrowthAtmosphere()
+        : IAtmosphereBoundary()
+    {
+    }
+    void setData(const ModelState::DataMap& ms) override
+    {
+        IAtmosphereBoundary::setData(ms);
+        for (size_t i = 0; i < qia.size(); ++i) {
+            qia[i] = 305.288 - 15. * (i % 41);
+            dqia_dt[i] = 4.5036;
+            qow[i] = 307.546 - 13. * (i % 41);
+        }
+        subl = 0.;
+        snow = 0.;
+        rain = 0.;
+        evap = 0.;
+        uwind = 0;
+        vwind = 0.;
+    }
+};
+
+// Ice free and ice covered elements, with land in some of them
+class GrowthPrognostics : public ModelComponent {
+public:
+    GrowthPrognostics()
+    {
+        registerProtectedArray(ProtectedArray::H_ICE, &hice);
+        registerProtectedArray(ProtectedArray::C_ICE, &cice);
+        registerProtectedArray(ProtectedArray::H_SNOW, &hsnow);
+        registerProtectedArray(ProtectedArray::T_ICE, &tice0);
+    }
+    std::string getName() const override { return "PrognosticData"; }
+
+    void setData(const ModelState::DataMap&) override
+    {
+        HField mask(ModelArray::Type::H);
+        mask.resize();
+        for (size_t i = 0; i < cice.size(); ++i) {
+            mask[i] = (i % 7 == 3) ? 0. : 1.;
+            cice[i] = 0.1 * (i % 11);
+            hice[i] = 0.05 * (i % 5) * cice[i]; // Cell averaged
+            hsnow[i] = 0.01 * (i % 3) * cice[i]; // Cell averaged
+        }
+        setOceanMask(mask);
+        tice0 = -2;
+    }
+
+    size_t nActive() const { return nActiveElements(); }
+
+    HField hice;
+    HField cice;
+    HField hsnow;
+    ZField tice0;
+
+    ModelState getState() const override { return ModelState(); }
+    ModelState getState(const OutputLevel&) const override { return getState(); }
+};
+
+class GrowthOcean : public IOceanBoundary {
+public:
+    GrowthOcean()
+        : IOceanBoundary()
+    {
+    }
+    void setData(const ModelState::DataMap& state) override
+    {
+        IOceanBoundary::setData(state);
+        qio = 124.689;
+        sst = -1.5;
+        sss = 32.;
+        mld = 10.25;
+        u = 0.;
+        v = 0.;
+    }
+    void updateBefore(const TimestepTime&) override
+    {
+        UnescoFreezing uf;
+        cpml = Water::cp * Water::rho * mld;
+        tf = uf(sss[0]);
+    }
+    void updateAfter(const TimestepTime&) override { }
+};
+
+TEST_CASE("Fused column update")
+{
+    const size_t nx = 6;
+    const size_t ny = 5;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+    ModelArray::setDimensions(ModelArray::Type::Z, { nx, ny, 1 });
+
+    GrowthAtmosphere atmBdy;
+    GrowthPrognostics proData;
+    GrowthOcean ocnBdy;
+
+    TimestepTime tst = { TimePoint("2000-001"), Duration("P0-1") };
+    // Runs one timestep of IceGrowth, returning the updated fields
+    auto runGrowth = [&atmBdy, &proData, &ocnBdy, &tst]() {
+        atmBdy.setData(ModelState().data);
+        proData.setData(ModelState().data);
+        ocnBdy.setData(ModelState().data);
+        IceGrowth ig;
+        ig.configure();
+        ig.setData(ModelState().data);
+        ocnBdy.updateBefore(tst);
+        ig.update(tst);
+
+        ModelArrayRef<ModelComponent::SharedArray::H_ICE, MARBackingStore, RO> hice(
+            ModelComponent::getSharedArray());
+        ModelArrayRef<ModelComponent::SharedArray::C_ICE, MARBackingStore, RO> cice(
+            ModelComponent::getSharedArray());
+        ModelArrayRef<ModelComponent::SharedArray::H_SNOW, MARBackingStore, RO> hsnow(
+            ModelComponent::getSharedArray());
+        ModelArrayRef<ModelComponent::SharedArray::NEW_ICE, MARBackingStore, RO> newice(
+            ModelComponent::getSharedArray());
+        ModelArrayRef<ModelComponent::SharedArray::Q_OW, MARBackingStore, RO> qow(
+            ModelComponent::getSharedArray());
+        ModelState::DataMap updated = {
+            { "hice", hice.data() },
+            { "cice", cice.data() },
+            { "hsnow", hsnow.data() },
+            { "newice", newice.data() },
+            { "qow", qow.data() },
+        };
+        return updated;
+    };
+
+    // Compares two sets of fields in all ocean elements
+    auto requireSameFields = [](const ModelState::DataMap& a, const ModelState::DataMap& b) {
+        for (const auto& [name, field] : a) {
+            INFO(name);
+            for (size_t i = 0; i < field.size(); ++i) {
+                // Ocean elements only
+                if (i % 7 != 3)
+                    REQUIRE(field[i] == b.at(name)[i]);
+            }
+        }
+    };
+
+    setGrowthConfig(false);
+    Module::Module<IIceThermodynamics>::setExternalImplementation(
+        Module::newImpl<IIceThermodynamics, ThermoIce0>);
+    ModelState::DataMap fused = runGrowth();
+    Module::Module<IIceThermodynamics>::setExternalImplementation(
+        Module::newImpl<IIceThermodynamics, ThermoIce0Unfused>);
+    ModelState::DataMap unfused = runGrowth();
+    requireSameFields(fused, unfused);
+    // Both freezing and melting took place
+    REQUIRE(fused.at("newice")[0] > 0);
+    REQUIRE(fused.at("cice")[nx * ny - 1] < 0.1 * ((nx * ny - 1) % 11));
+
+    // Restricting the full calculation to the active cells gives the same
+    // results, with some cells left out
+    setGrowthConfig(true);
+    ModelState::DataMap unfusedActive = runGrowth();
+    REQUIRE(proData.nActive() > 0);
+    REQUIRE(proData.nActive() < nx * ny);
+    requireSameFields(fused, unfusedActive);
+    Module::Module<IIceThermodynamics>::setExternalImplementation(
+        Module::newImpl<IIceThermodynamics, ThermoIce0>);
+    ModelState::DataMap fusedActive = runGrowth();
+    requireSameFields(fused, fusedActive);
+}
+
+// Times the single pass over the columns against the split update, which makes
+// separate sweeps to initialize the thicknesses, to apply the vertical
+// thermodynamics and to form and spread the new ice. It runs on the 128x128
+// test grid and on a grid the size of the 25 km Arctic grid. The timings are
+// reported, but not tested.
+TEST_CASE("Fused column update microbenchmark")
+{
+    setGrowthConfig(false);
+    TimestepTime tst = { TimePoint("2000-001"), Duration("P0-0T0:10:0") };
+    const size_t nRepeats = 3;
+
+    for (const auto& [nx, ny] : { std::pair<size_t, size_t>(128, 128), { 304, 448 } }) {
+        ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+        ModelArray::setDimensions(ModelArray::Type::Z, { nx, ny, 1 });
+
+        GrowthAtmosphere atmBdy;
+        GrowthPrognostics proData;
+        GrowthOcean ocnBdy;
+
+        // The mean time of an IceGrowth update in milliseconds
+        auto timeGrowth = [&atmBdy, &proData, &ocnBdy, &tst, nRepeats]() {
+            atmBdy.setData(ModelState().data);
+            proData.setData(ModelState().data);
+            ocnBdy.setData(ModelState().data);
+            IceGrowth ig;
+            ig.configure();
+            ig.setData(ModelState().data);
+            ocnBdy.updateBefore(tst);
+
+            auto start = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < nRepeats; ++r) {
+                ig.update(tst);
+            }
+            std::chrono::duration<double, std::milli> elapsed
+                = std::chrono::steady_clock::now() - start;
+            return elapsed.count() / nRepeats;
+        };
+
+        Module::Module<IIceThermodynamics>::setExternalImplementation(
+            Module::newImpl<IIceThermodynamics, ThermoIce0>);
+        double fusedTime = timeGrowth();
+        Module::Module<IIceThermodynamics>::setExternalImplementation(
+            Module::newImpl<IIceThermodynamics, ThermoIce0Unfused>);
+        double splitTime = timeGrowth();
+
+        const double nsPerElement = 1.e6 / (nx * ny);
+        MESSAGE(nx << "x" << ny << " fused update: " << fusedTime << " ms, "
+                   << fusedTime * nsPerElement << " ns per element");
+        MESSAGE(nx << "x" << ny << " split update: " << splitTime << " ms, "
+                   << splitTime * nsPerElement << " ns per element");
+        MESSAGE(nx << "x" << ny << " speed up of the single pass: " << splitTime / fusedTime);
+    }
+}
+
 TEST_SUITE_END();
 
 }
@@ -34,6 +34,59 @@ TEST_CASE("Specific humidity test")
     REQUIRE(0.00323958 == doctest::Approx(ice).epsilon(prec));
 
 }
+
+TEST_CASE("Array specific humidity test")
+{
+    // More than one block of values, and not a multiple of the vector width
+    const size_t nx = 29;
+    const size_t ny = 23;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+
+    HField temp(ModelArray::Type::H);
+    HField pres(ModelArray::Type::H);
+    HField sal(ModelArray::Type::H);
+    temp.resize();
+    pres.resize();
+    sal.resize();
+    for (size_t i = 0; i < temp.size(); ++i) {
+        temp[i] = -40. + 0.1 * i;
+        pres[i] = 95000. + 17. * i;
+        sal[i] = 0.05 * i;
+    }
+
+    // The output arrays are sized by the calculation
+    HField out(ModelArray::Type::H);
+    HField dOut(ModelArray::Type::H);
+
+    const double prec = 1e-12;
+    for (FiniteElementSpecHum* fesh : { &FiniteElementSpecHum::water(), &FiniteElementSpecHum::ice() }) {
+        fesh->evaluate(temp, pres, out);
+        REQUIRE(out.trueSize() == temp.size());
+        for (size_t i = 0; i < out.size(); ++i) {
+            REQUIRE(out[i] == doctest::Approx((*fesh)(temp[i], pres[i])).epsilon(prec));
+        }
+
+        fesh->evaluate(temp, pres, sal, out);
+        for (size_t i = 0; i < out.size(); ++i) {
+            REQUIRE(out[i] == doctest::Approx((*fesh)(temp[i], pres[i], sal[i])).epsilon(prec));
+        }
+
+        fesh->valueAndDerivative(temp, pres, out, dOut);
+        REQUIRE(dOut.trueSize() == temp.size());
+        for (size_t i = 0; i < out.size(); ++i) {
+            std::pair<double, double> scalar = fesh->valueAndDerivative(temp[i], pres[i]);
+            REQUIRE(out[i] == doctest::Approx(scalar.first).epsilon(prec));
+            REQUIRE(dOut[i] == doctest::Approx(scalar.second).epsilon(prec));
+        }
+
+        fesh->valueAndDerivative(temp, pres, sal, out, dOut);
+        for (size_t i = 0; i < out.size(); ++i) {
+            std::pair<double, double> scalar = fesh->valueAndDerivative(temp[i], pres[i], sal[i]);
+            REQUIRE(out[i] == doctest::Approx(scalar.first).epsilon(prec));
+            REQUIRE(dOut[i] == doctest::Approx(scalar.second).epsilon(prec));
+        }
+    }
+}
 TEST_SUITE_END();
 
 } /* namespace Nextsim */
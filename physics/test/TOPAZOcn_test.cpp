@@ -13,7 +13,9 @@
 #include "include/IFluxCalculation.hpp"
 #include "include/ModelArrayRef.hpp"
 #include "include/Time.hpp"
+#include "include/constants.hpp"
 
+#include <algorithm>
 #include <filesystem>
 
 #define TO_STR(s) TO_STRI(s)
@@ -24,26 +26,30 @@
 
 namespace Nextsim {
 
-TEST_SUITE_BEGIN("TOPAZOcean");
-TEST_CASE("TOPAZOcean test")
+/*
+ * Copies the test forcing file from the test source directory to the working
+ * directory, and sets the array sizes to match it. In the real model, the
+ * array sizes will have been set by the restart file by this point.
+ */
+static void prepareForcingFile(const std::string& filePath)
 {
-    std::string filePath = "topaz_test128x128.nc";
     std::string sourceDir = TO_STR(TEST_FILE_SOURCE);
-    // Copy the test file from the test source directory to the working directory
     if (!std::filesystem::exists(filePath)) {
         std::filesystem::copy(sourceDir + "/" + filePath, ".");
     }
-
-    // In the real model, the array sizes will have been set by the restart file by this point
     size_t nx = 128;
     size_t ny = 128;
-    size_t nxvertex = nx + 1;
-    size_t nyvertex = ny + 1;
-
     ModelArray::setDimension(ModelArray::Dimension::X, nx);
     ModelArray::setDimension(ModelArray::Dimension::Y, ny);
-    ModelArray::setDimension(ModelArray::Dimension::XVERTEX, nxvertex);
-    ModelArray::setDimension(ModelArray::Dimension::YVERTEX, nyvertex);
+    ModelArray::setDimension(ModelArray::Dimension::XVERTEX, nx + 1);
+    ModelArray::setDimension(ModelArray::Dimension::YVERTEX, ny + 1);
+}
+
+TEST_SUITE_BEGIN("TOPAZOcean");
+TEST_CASE("TOPAZOcean test")
+{
+    std::string filePath = "topaz_test128x128.nc";
+    prepareForcingFile(filePath);
 
     TOPAZOcean topaz;
     topaz.configure();
@@ -108,5 +114,50 @@ TEST_CASE("TOPAZOcean test")
 
     std::filesystem::remove(filePath);
 }
+
+TEST_CASE("TOPAZOcean forcing prefetch and interpolation")
+{
+    std::string filePath = "topaz_test128x128.nc";
+    prepareForcingFile(filePath);
+
+    TOPAZOcean topaz;
+    topaz.configure();
+    topaz.setFilePath(filePath);
+    topaz.setPrefetch(true);
+    topaz.setInterpolate(true);
+
+    ModelArrayRef<ModelComponent::ProtectedArray::EXT_SST, MARConstBackingStore> sst(
+        ModelComponent::getProtectedArray());
+    ModelArrayRef<ModelComponent::ProtectedArray::MLD, MARConstBackingStore> mld(
+        ModelComponent::getProtectedArray());
+    ModelArrayRef<ModelComponent::ProtectedArray::ML_BULK_CP, MARConstBackingStore> cpml(
+        ModelComponent::getProtectedArray());
+
+    HField cice(ModelArray::Type::H);
+    cice = 0.;
+    ModelComponent::registerExternalProtectedArray(ModelComponent::ProtectedArray::C_ICE, &cice);
+
+    double mdi = -2.03703597633448608e90;
+    double targetFrac = 35 * 0.001 + 45 * 0.000001;
+
+    // Daily steps through the records, which are 30 days apart and are read
+    // ahead in the background. Between records the fields are interpolated.
+    TimePoint t1("2000-01-01T00:00:00Z");
+    const double day = 86400.;
+    for (int iDay = 0; iDay < 366; ++iDay) {
+        topaz.updateBefore({ t1 + Duration(iDay * day), Duration(600) });
+        // After the last record, the fields are those of the last record
+        double offset = std::min(iDay / 30., 11.);
+        // Missing data stays missing
+        REQUIRE(sst(0, 0) == mdi);
+        REQUIRE(sst(32, 32) == doctest::Approx(-0.032032 - offset));
+        REQUIRE(sst(45, 35) == doctest::Approx(-(0 + targetFrac) - offset));
+        REQUIRE(mld(45, 35) == doctest::Approx((10 + targetFrac) + offset));
+        // The heat capacity follows the interpolated mixed layer depth
+        REQUIRE(cpml(45, 35) == doctest::Approx(Water::rho * Water::cp * mld(45, 35)));
+    }
+
+    std::filesystem::remove(filePath);
+}
 TEST_SUITE_END();
 }
@@ -390,6 +390,187 @@ TEST_CASE("No ice do nothing")
     REQUIRE(cice[0] == 0);
 }
 
+// Configures the modules and whether the Winton columns are calculated in batches
+static void configureBatched(bool batched)
+{
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "Nextsim::IFreezingPoint = Nextsim::UnescoFreezing" << std::endl;
+    config << std::endl;
+    config << "[ThermoWinton]" << std::endl;
+    config << "batched = " << (batched ? "true" : "false") << std::endl;
+
+    Configurator::clear();
+    std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+    Configurator::addStream(std::move(pcstream));
+
+    ConfiguredModule::parseConfigurator();
+}
+
+TEST_CASE("Batched and single column calculations")
+{
+    // Two full batches and a partial one, with one land element
+    const size_t nx = 7;
+    const size_t ny = 3;
+    ModelArray::setDimensions(ModelArray::Type::H, { nx, ny });
+    ModelArray::setDimensions(ModelArray::Type::Z, { nx, ny, 3 });
+    const size_t landIndex = 9;
+
+    configureBatched(false);
+
+    ThermoWinton twin;
+    // Ice free, thin, thick, snow covered and flooded columns
+    class IceTemperatureData : public ModelComponent {
+    public:
+        IceTemperatureData()
+            : tice0(ModelArray::Type::Z)
+            , tice(getSharedArray())
+        {
+            registerProtectedArray(ProtectedArray::HTRUE_ICE, &hice0);
+            registerProtectedArray(ProtectedArray::C_ICE, &cice0);
+            registerProtectedArray(ProtectedArray::HTRUE_SNOW, &hsnow0);
+            registerProtectedArray(ProtectedArray::SW_IN, &sw_in);
+            registerProtectedArray(ProtectedArray::T_ICE, &tice0);
+
+            registerSharedArray(SharedArray::H_ICE, &hice);
+            registerSharedArray(SharedArray::C_ICE, &cice);
+            registerSharedArray(SharedArray::H_SNOW, &hsnow);
+        }
+        std::string getName() const override { return "IceTemperatureData"; }
+        void setMask(const ModelArray& mask) { setOceanMask(mask); }
+        void resetMask() { noLandMask(); }
+
+        void setData(const ModelState::DataMap&) override
+        {
+            hice0.resize();
+            cice0.resize();
+            hsnow0.resize();
+            sw_in.resize();
+            tice0.resize();
+            for (size_t i = 0; i < hice0.size(); ++i) {
+                cice0[i] = (i % 5 == 0) ? 0. : 0.2 * (i % 5);
+                hice0[i] = (i % 5 == 0) ? 0. : 0.005 + 0.4 * (i % 4);
+                hsnow0[i] = (i % 6 == 1) ? 1.2 : 0.03 * (i % 3);
+                sw_in[i] = 0.;
+                tice0.zIndexAndLayer(i, 0) = -0.5 - 1.5 * (i % 7);
+                tice0.zIndexAndLayer(i, 1) = -0.4 - 1.1 * (i % 5);
+                tice0.zIndexAndLayer(i, 2) = -0.3 - 0.5 * (i % 3);
+            }
+            tice.data().setData(tice0);
+
+            hice = hice0;
+            cice = cice0;
+            hsnow = hsnow0;
+        }
+
+        HField hice0;
+        HField cice0;
+        HField hsnow0;
+        HField sw_in;
+        ZField tice0;
+        ModelArrayRef<SharedArray::T_ICE, MARBackingStore, RW> tice; // From IIceThermodynamics
+
+        HField hice;
+        HField cice;
+        HField hsnow;
+
+        ModelState getState() const override { return ModelState(); }
+        ModelState getState(const OutputLevel&) const override { return getState(); }
+    } initCond;
+
+    // Freezing and melting from below
+    class OceanState : public IOceanBoundary {
+    public:
+        void setData(const ModelState::DataMap& ms) override
+        {
+            IOceanBoundary::setData(ms);
+            for (size_t i = 0; i < sst.size(); ++i) {
+                sst[i] = -1.;
+                sss[i] = 30. + 0.2 * i;
+                tf[i] = Module::getImplementation<IFreezingPoint>()(sss[i]);
+                cpml[i] = 4.29151e7;
+                qio[i] = (i % 3 == 0) ? -30. : 150. * (i % 3);
+            }
+        }
+        void updateBefore(const TimestepTime& tst) override { }
+        void updateAfter(const TimestepTime& tst) override { }
+    } oceanData;
+
+    // Surface melting and cooling, with and without sublimation and snowfall
+    class AtmosphereState : public IAtmosphereBoundary {
+    public:
+        void setData(const ModelState::DataMap& ms) override
+        {
+            IAtmosphereBoundary::setData(ms);
+            for (size_t i = 0; i < qia.size(); ++i) {
+                snow[i] = (i % 4 == 2) ? 1e-3 : 0.;
+                qow[i] = -100.;
+                qia[i] = (i % 2) ? -120. + 3. * i : 40. + 2. * i;
+                dqia_dt[i] = 15. + 0.5 * i;
+                subl[i] = (i % 8 == 3) ? 0.3 : 1e-6 * (i % 4);
+                penSW[i] = (i % 2) ? 2. : 0.;
+            }
+        }
+    } atmosState;
+
+    TimestepTime tst = { TimePoint("2000-001"), Duration("P0-0T0:10:0") };
+
+    ModelArrayRef<ModelComponent::SharedArray::H_ICE, MARBackingStore, RO> hice(
+        ModelComponent::getSharedArray());
+    ModelArrayRef<ModelComponent::SharedArray::H_SNOW, MARBackingStore, RO> hsnow(
+        ModelComponent::getSharedArray());
+    ModelArrayRef<ModelComponent::SharedArray::T_ICE, MARBackingStore, RO> tice(
+        ModelComponent::getSharedArray());
+    ModelArrayRef<ModelComponent::SharedArray::Q_IO, MARBackingStore, RO> qio(
+        ModelComponent::getSharedArray());
+    ModelArrayRef<ModelComponent::SharedArray::DELTA_HICE, MARBackingStore, RO> deltaHi(
+        ModelComponent::getSharedArray());
+
+    std::vector<HField> single;
+    for (bool batched : { false, true }) {
+        configureBatched(batched);
+        twin.configure();
+        twin.setData(ModelState().data);
+        initCond.setData(ModelState().data);
+        oceanData.setData(ModelState().data);
+        atmosState.setData(ModelState().data);
+        HField mask(ModelArray::Type::H);
+        mask.resize();
+        mask = 1.;
+        mask[landIndex] = 0.;
+        initCond.setMask(mask);
+
+        REQUIRE(twin.hasElementUpdate() != batched);
+        twin.update(tst);
+
+        std::vector<HField> results = { hice.data(), hsnow.data(), qio.data(), deltaHi.data() };
+        HField tLayers[3]
+            = { HField(ModelArray::Type::H), HField(ModelArray::Type::H), HField(ModelArray::Type::H) };
+        for (size_t layer = 0; layer < 3; ++layer) {
+            tLayers[layer].resize();
+            for (size_t i = 0; i < tLayers[layer].size(); ++i) {
+                tLayers[layer][i] = tice.data().zIndexAndLayer(i, layer);
+            }
+            results.push_back(tLayers[layer]);
+        }
+
+        if (!batched) {
+            single = results;
+            continue;
+        }
+        for (size_t f = 0; f < results.size(); ++f) {
+            for (size_t i = 0; i < results[f].size(); ++i) {
+                // Land values are not calculated
+                if (i == landIndex)
+                    continue;
+                REQUIRE(results[f][i] == doctest::Approx(single[f][i]).epsilon(1e-12));
+            }
+        }
+    }
+    // Restore the all-ocean mask
+    initCond.resetMask();
+}
+
 TEST_SUITE_END();
 
 }